@@ -17,32 +17,35 @@
 
 #include "AudioQueue.hxx"
 
-using std::mutex;
-using std::lock_guard;
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
   : myFragmentSize(fragmentSize),
     myIsStereo(isStereo),
     myFragmentQueue(capacity),
-    myAllFragments(capacity + 2),
-    mySize(0),
-    myNextFragment(0),
+    myFreeFragments(capacity + 2),
+    myAllFragments(capacity + 3),
+    myIndexRange(capacity * (0x80000000 / std::max(capacity, 1u))),
+    myReadIndex(0),
+    myWriteIndex(0),
+    myFreeReadIndex(0),
+    myFreeWriteIndex(capacity + 1),
     myIgnoreOverflows(true),
     myOverflowLogger("audio buffer overflow", 1)
 {
   const uInt8 sampleSize = myIsStereo ? 2 : 1;
 
-  myFragmentBuffer = make_unique<Int16[]>(myFragmentSize * sampleSize * (capacity + 2));
+  myFragmentBuffer = make_unique<Int16[]>(myFragmentSize * sampleSize * (capacity + 3));
 
-  for (uInt32 i = 0; i < capacity; ++i)
-    myFragmentQueue[i] = myAllFragments[i] = myFragmentBuffer.get() + i * sampleSize * myFragmentSize;
+  for (uInt32 i = 0; i < capacity + 3; ++i)
+    myAllFragments[i] = myFragmentBuffer.get() + i * sampleSize * myFragmentSize;
 
-  myAllFragments[capacity] = myFirstFragmentForEnqueue =
-    myFragmentBuffer.get() + capacity * sampleSize * myFragmentSize;
+  // The consumer may hold two fragments while it swaps the played fragment
+  // for a new one, so one fragment more than the capacity is free initially.
+  for (uInt32 i = 0; i < capacity + 1; ++i)
+    myFreeFragments[i] = myAllFragments[i];
 
-  myAllFragments[capacity + 1] = myFirstFragmentForDequeue =
-    myFragmentBuffer.get() + (capacity + 1) * sampleSize * myFragmentSize;
+  myFirstFragmentForEnqueue = myAllFragments[capacity + 1];
+  myFirstFragmentForDequeue = myAllFragments[capacity + 2];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -52,11 +55,12 @@ uInt32 AudioQueue::capacity() const
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 AudioQueue::size()
+uInt32 AudioQueue::size() const
 {
-  lock_guard<mutex> guard(myMutex);
+  const uInt32 readIndex = myReadIndex.load();
 
-  return mySize;
+  // The producer may have dropped a fragment since we read the read index
+  return std::min(distance(readIndex, myWriteIndex.load()), capacity());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -74,8 +78,6 @@ uInt32 AudioQueue::fragmentSize() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::enqueue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   Int16* newFragment;
 
   if (!fragment) {
@@ -87,40 +89,67 @@ Int16* AudioQueue::enqueue(Int16* fragment)
     return newFragment;
   }
 
-  const uInt8 capacity = uInt8(myFragmentQueue.size());
-  const uInt8 fragmentIndex = (myNextFragment + mySize) % capacity;
+  // Only the producer advances the write index
+  const uInt32 writeIndex = myWriteIndex.load(std::memory_order_relaxed);
+  uInt32 readIndex = myReadIndex.load();
+
+  while (true) {
+    if (distance(readIndex, writeIndex) < capacity()) {
+      // There is room in the queue, so a played fragment is waiting for us
+      const uInt32 freeIndex = myFreeReadIndex.load(std::memory_order_relaxed);
+      if (freeIndex == myFreeWriteIndex.load(std::memory_order_acquire))
+        throw runtime_error("audio queue out of fragments");
 
-  newFragment = myFragmentQueue.at(fragmentIndex);
-  myFragmentQueue.at(fragmentIndex) = fragment;
+      newFragment = myFreeFragments[freeIndex];
+      myFreeReadIndex.store((freeIndex + 1) % myFreeFragments.size(), std::memory_order_release);
 
-  if (mySize < capacity) ++mySize;
-  else {
-    myNextFragment = (myNextFragment + 1) % capacity;
-    if (!myIgnoreOverflows) myOverflowLogger.log();
+      break;
+    }
+
+    // The queue is full: drop the oldest fragment, unless the consumer
+    // claimed it in the meantime
+    newFragment = myFragmentQueue[readIndex % capacity()].load();
+    if (myReadIndex.compare_exchange_weak(readIndex, nextIndex(readIndex))) {
+      if (!myIgnoreOverflows) myOverflowLogger.log();
+
+      break;
+    }
   }
 
+  myFragmentQueue[writeIndex % capacity()].store(fragment);
+  myWriteIndex.store(nextIndex(writeIndex));
+
   return newFragment;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::dequeue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
+  if (!fragment && !myFirstFragmentForDequeue) {
+    if (size() == 0) return nullptr;
 
-  if (mySize == 0) return nullptr;
+    throw runtime_error("dequeue called empty");
+  }
 
-  if (!fragment) {
-    if (!myFirstFragmentForDequeue) throw runtime_error("dequeue called empty");
+  uInt32 readIndex = myReadIndex.load();
+  Int16* nextFragment;
+
+  // The producer may drop the fragment we are about to claim
+  do {
+    if (readIndex == myWriteIndex.load()) return nullptr;
 
+    nextFragment = myFragmentQueue[readIndex % capacity()].load();
+  } while (!myReadIndex.compare_exchange_weak(readIndex, nextIndex(readIndex)));
+
+  if (!fragment) {
     fragment = myFirstFragmentForDequeue;
     myFirstFragmentForDequeue = nullptr;
   }
 
-  Int16* nextFragment = myFragmentQueue.at(myNextFragment);
-  myFragmentQueue.at(myNextFragment) = fragment;
-
-  --mySize;
-  myNextFragment = (myNextFragment + 1) % myFragmentQueue.size();
+  // Return the played fragment to the producer
+  const uInt32 freeIndex = myFreeWriteIndex.load(std::memory_order_relaxed);
+  myFreeFragments[freeIndex] = fragment;
+  myFreeWriteIndex.store((freeIndex + 1) % myFreeFragments.size(), std::memory_order_release);
 
   return nextFragment;
 }
@@ -128,8 +157,6 @@ Int16* AudioQueue::dequeue(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::closeSink(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   if (myFirstFragmentForDequeue && fragment)
     throw new runtime_error("attempt to return unknown buffer on closeSink");
 
@@ -142,3 +169,15 @@ void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
   myIgnoreOverflows = shouldIgnoreOverflows;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioQueue::nextIndex(uInt32 index) const
+{
+  return index + 1 == myIndexRange ? 0 : index + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioQueue::distance(uInt32 readIndex, uInt32 writeIndex) const
+{
+  return writeIndex >= readIndex ? writeIndex - readIndex : writeIndex + myIndexRange - readIndex;
+}
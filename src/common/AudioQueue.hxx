@@ -18,7 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
-#include <mutex>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -33,6 +33,14 @@
   The queue needs to be threadsafe as the (SDL) audio driver runs on a
   separate thread. Samples are stored as signed 16 bit integers
   (platform endian).
+
+  There must be exactly one producer (the thread calling enqueue) and one
+  consumer (the thread calling dequeue and closeSink).  Neither of them ever
+  blocks: filled fragments are passed in a ring of atomic slots, and played
+  fragments are returned to the producer through a second ring.  On
+  overflow, the producer drops the oldest queued fragment by advancing the
+  read index itself; producer and consumer agree on who claimed a fragment
+  through a compare-and-swap on that index.
 */
 class AudioQueue
 {
@@ -55,7 +63,7 @@ class AudioQueue
     /**
       Size getter.
      */
-    uInt32 size();
+    uInt32 size() const;
 
     /**
       Stereo / mono getter.
@@ -96,6 +104,18 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+  private:
+
+    /**
+      Advance an index into the fragment queue (see myIndexRange).
+     */
+    uInt32 nextIndex(uInt32 index) const;
+
+    /**
+      The number of queued fragments between the read and write indices.
+     */
+    uInt32 distance(uInt32 readIndex, uInt32 writeIndex) const;
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -104,23 +124,30 @@ class AudioQueue
     // Are we using stereo samples?
     bool myIsStereo;
 
-    // The fragment queue
-    vector<Int16*> myFragmentQueue;
+    // The fragment queue; fragment i is stored in slot i % capacity
+    vector<std::atomic<Int16*>> myFragmentQueue;
+
+    // Played fragments, returned by the consumer to the producer
+    vector<Int16*> myFreeFragments;
 
-    // All fragments, including the two fragments that are in circulation.
+    // All fragments, including the three fragments that are in circulation.
     vector<Int16*> myAllFragments;
 
     // We allocate a consecutive slice of memory for the fragments.
     unique_ptr<Int16[]> myFragmentBuffer;
 
-    // The nubmer if queued fragments
-    uInt32 mySize;
+    // The fragment queue indices wrap at this multiple of the capacity.  It is
+    // large enough that a compare-and-swap on the read index cannot succeed
+    // on a stale value.
+    uInt32 myIndexRange;
 
-    // The next fragment.
-    uInt32 myNextFragment;
+    // The next fragment to dequeue, and the slot the next fragment is enqueued to
+    std::atomic<uInt32> myReadIndex;
+    std::atomic<uInt32> myWriteIndex;
 
-    // We need a mutex for thread safety.
-    std::mutex myMutex;
+    // Indices into myFreeFragments (written by the producer and the consumer, resp.)
+    std::atomic<uInt32> myFreeReadIndex;
+    std::atomic<uInt32> myFreeWriteIndex;
 
     // The first (empty) enqueue call returns this fragment.
     Int16* myFirstFragmentForEnqueue;
@@ -128,7 +155,7 @@ class AudioQueue
     Int16* myFirstFragmentForDequeue;
 
     // Log overflows?
-    bool myIgnoreOverflows;
+    std::atomic<bool> myIgnoreOverflows;
 
     StaggeredLogger myOverflowLogger;
 
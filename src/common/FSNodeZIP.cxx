@@ -17,6 +17,7 @@
 
 #if defined(ZIP_SUPPORT)
 
+#include <mutex>
 #include <set>
 
 #include "bspf.hxx"
@@ -48,6 +49,9 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
 
   _zipFile = p.substr(0, pos+4);
 
+  // The ZIP handler is shared, so only one thread may use it at a time
+  std::lock_guard<std::mutex> lock(myZipMutex);
+
   // Open file at least once to initialize the virtual file count
   try
   {
@@ -153,6 +157,7 @@ bool FilesystemNodeZIP::getChildren(AbstractFSList& myList, ListMode mode,
     return false;
 
   std::set<string> dirs;
+  std::lock_guard<std::mutex> lock(myZipMutex);
   myZipHandler->open(_zipFile);
   while(myZipHandler->hasNext())
   {
@@ -194,6 +199,7 @@ uInt32 FilesystemNodeZIP::read(ByteBuffer& image) const
     case zip_error::NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
+  std::lock_guard<std::mutex> lock(myZipMutex);
   myZipHandler->open(_zipFile);
 
   bool found = false;
@@ -217,5 +223,6 @@ AbstractFSNodePtr FilesystemNodeZIP::getParent() const
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<ZipHandler> FilesystemNodeZIP::myZipHandler = make_unique<ZipHandler>();
+std::mutex FilesystemNodeZIP::myZipMutex;
 
 #endif  // ZIP_SUPPORT
@@ -20,6 +20,8 @@
 #ifndef FS_NODE_ZIP_HXX
 #define FS_NODE_ZIP_HXX
 
+#include <mutex>
+
 #include "ZipHandler.hxx"
 #include "FSNode.hxx"
 
@@ -67,6 +69,10 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     uInt32 read(ByteBuffer& image) const override;
 
+    // A ROM inside a ZIP file is considered changed whenever the ZIP file is
+    bool getFileInfo(uInt64& size, uInt64& modified) const override
+      { return _realNode && _realNode->getFileInfo(size, modified); }
+
   private:
     FilesystemNodeZIP(const string& zipfile, const string& virtualpath,
         AbstractFSNodePtr realnode, bool isdir);
@@ -107,6 +113,10 @@ class FilesystemNodeZIP : public AbstractFSNode
     // ZipHandler static reference variable responsible for accessing ZIP files
     static unique_ptr<ZipHandler> myZipHandler;
 
+    // Serializes access to the ZipHandler, since ZIP files may also be read
+    // from other threads (ie, by the launcher when preparing ROM info)
+    static std::mutex myZipMutex;
+
     // Get last component of path
     static const char* lastPathComponent(const string& str)
     {
@@ -72,6 +72,17 @@ class LinkedObjectPool
     */
     T& current() const { return *myCurrent; }
 
+    /**
+      Return node data that the given iterator points to, for modification.
+    */
+    T& node(const_iter i) const { return const_cast<T&>(*i); }
+
+    /**
+      Return an iterator to the 'current' node.
+      Make sure to call 'currentIsValid()' before accessing this method.
+    */
+    const_iter currentIter() const { return myCurrent; }
+
     /**
       Returns current's position in the list
 
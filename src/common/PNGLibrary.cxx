@@ -40,6 +40,15 @@ PNGLibrary::PNGLibrary(OSystem& osystem)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
+{
+  readImage(filename, myReadImage);
+
+  // Load image into the surface, setting the correct dimensions
+  loadImage(myReadImage, surface);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::readImage(const string& filename, Image& image)
 {
   png_structp png_ptr = nullptr;
   png_infop info_ptr = nullptr;
@@ -102,22 +111,20 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
   }
 
   // Create/initialize storage area for the current image
-  if(!allocateStorage(iwidth, iheight))
+  if(!allocateStorage(image, iwidth, iheight))
     loadImageERROR("Not enough memory to read PNG file");
 
   // The PNG read function expects an array of rows, not a single 1-D array
-  for(uInt32 irow = 0, offset = 0; irow < ReadInfo.height; ++irow, offset += ReadInfo.pitch)
-    ReadInfo.row_pointers[irow] = png_bytep(ReadInfo.buffer.get() + offset);
+  unique_ptr<png_bytep[]> row_pointers = make_unique<png_bytep[]>(image.height);
+  for(uInt32 irow = 0, offset = 0; irow < image.height; ++irow, offset += image.pitch)
+    row_pointers[irow] = png_bytep(image.buffer.get() + offset);
 
   // Read the entire image in one go
-  png_read_image(png_ptr, ReadInfo.row_pointers.get());
+  png_read_image(png_ptr, row_pointers.get());
 
   // We're finished reading
   png_read_end(png_ptr, info_ptr);
 
-  // Load image into the surface, setting the correct dimensions
-  loadImagetoSurface(surface);
-
   // Cleanup
   if(png_ptr)
     png_destroy_read_struct(&png_ptr, info_ptr ? &info_ptr : nullptr, nullptr);
@@ -382,40 +389,31 @@ void PNGLibrary::takeSnapshot(uInt32 number)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool PNGLibrary::allocateStorage(png_uint_32 w, png_uint_32 h)
+bool PNGLibrary::allocateStorage(Image& image, png_uint_32 w, png_uint_32 h)
 {
   // Create space for the entire image (3 bytes per pixel in RGB format)
   uInt32 req_buffer_size = w * h * 3;
-  if(req_buffer_size > ReadInfo.buffer_size)
+  if(req_buffer_size > image.buffer_size)
   {
-    ReadInfo.buffer = make_unique<png_byte[]>(req_buffer_size);
-    if(ReadInfo.buffer == nullptr)
+    image.buffer = make_unique<png_byte[]>(req_buffer_size);
+    if(image.buffer == nullptr)
       return false;
 
-    ReadInfo.buffer_size = req_buffer_size;
+    image.buffer_size = req_buffer_size;
   }
-  uInt32 req_row_size = h;
-  if(req_row_size > ReadInfo.row_size)
-  {
-    ReadInfo.row_pointers = make_unique<png_bytep[]>(req_row_size);
-    if(ReadInfo.row_pointers == nullptr)
-      return false;
 
-    ReadInfo.row_size = req_row_size;
-  }
-
-  ReadInfo.width  = w;
-  ReadInfo.height = h;
-  ReadInfo.pitch  = w * 3;
+  image.width  = w;
+  image.height = h;
+  image.pitch  = w * 3;
 
   return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::loadImagetoSurface(FBSurface& surface)
+void PNGLibrary::loadImage(const Image& image, FBSurface& surface)
 {
   // First determine if we need to resize the surface
-  uInt32 iw = ReadInfo.width, ih = ReadInfo.height;
+  uInt32 iw = image.width, ih = image.height;
   if(iw > surface.width() || ih > surface.height())
     surface.resize(iw, ih);
 
@@ -427,15 +425,15 @@ void PNGLibrary::loadImagetoSurface(FBSurface& surface)
   // Convert RGB triples into pixels and store in the surface
   uInt32 *s_buf, s_pitch;
   surface.basePtr(s_buf, s_pitch);
-  uInt8* i_buf = ReadInfo.buffer.get();
-  uInt32 i_pitch = ReadInfo.pitch;
+  const uInt8* i_buf = image.buffer.get();
+  uInt32 i_pitch = image.pitch;
 
   const FrameBuffer& fb = myOSystem.frameBuffer();
   for(uInt32 irow = 0; irow < ih; ++irow, i_buf += i_pitch, s_buf += s_pitch)
   {
-    uInt8*  i_ptr = i_buf;
+    const uInt8* i_ptr = i_buf;
     uInt32* s_ptr = s_buf;
-    for(uInt32 icol = 0; icol < ReadInfo.width; ++icol, i_ptr += 3)
+    for(uInt32 icol = 0; icol < iw; ++icol, i_ptr += 3)
       *s_ptr++ = fb.mapRGB(*i_ptr, *(i_ptr+1), *(i_ptr+2));
   }
 }
@@ -491,9 +489,4 @@ void PNGLibrary::png_user_error(png_structp ctx, png_const_charp str)
   throw runtime_error(string("PNGLibrary error: ") + str);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-PNGLibrary::ReadInfoType PNGLibrary::ReadInfo = {
-  nullptr, nullptr, 0, 0, 0, 0, 0
-};
-
 #endif  // PNG_SUPPORT
@@ -54,6 +54,39 @@ class PNGLibrary
     */
     void loadImage(const string& filename, FBSurface& surface);
 
+    /**
+      The pixels of a PNG image, as RGB triples.  The memory is reused by
+      subsequent reads into the same image if it is large enough.
+    */
+    struct Image {
+      ByteBuffer buffer;
+      png_uint_32 width{0}, height{0}, pitch{0};
+      uInt32 buffer_size{0};
+    };
+
+    /**
+      Read a PNG image from the specified file.  This doesn't depend on
+      anything but the file, so it may be used from any thread.
+
+      @param filename  The filename to load the PNG image
+      @param image     The image into which to place the PNG data
+
+      @post  On success, the image contains the PNG data, otherwise a
+             runtime_error is thrown containing a more detailed
+             error message.
+    */
+    static void readImage(const string& filename, Image& image);
+
+    /**
+      Load an image previously read by readImage() into a FBSurface
+      structure.  The surface is resized as necessary to accommodate
+      the data.
+
+      @param image    The PNG data
+      @param surface  The FBSurface into which to place the PNG data
+    */
+    void loadImage(const Image& image, FBSurface& surface);
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -134,29 +167,24 @@ class PNGLibrary
     uInt32 mySnapInterval;
     uInt32 mySnapCounter;
 
-    // The following data remains between invocations of allocateStorage,
-    // and is only changed when absolutely necessary.
-    struct ReadInfoType {
-      ByteBuffer buffer;
-      unique_ptr<png_bytep[]> row_pointers;
-      png_uint_32 width, height, pitch;
-      uInt32 buffer_size, row_size;
-    };
-    static ReadInfoType ReadInfo;
+    // The image data of loadImage() remains between invocations, and is
+    // only reallocated when absolutely necessary
+    Image myReadImage;
 
     /**
       Allocate memory for PNG read operations.  This is used to provide a
       basic memory manager, so that we don't constantly allocate and deallocate
       memory for each image loaded.
 
-      The method fills the 'ReadInfo' struct with valid memory locations
-      dependent on the given dimensions.  If memory has been previously
-      allocated and it can accommodate the given dimensions, it is used directly.
+      The method fills the given image with valid memory locations dependent
+      on the given dimensions.  If memory has been previously allocated and
+      it can accommodate the given dimensions, it is used directly.
 
+      @param image   The image to allocate memory for
       @param iwidth  The width of the PNG image
       @param iheight The height of the PNG image
     */
-    bool allocateStorage(png_uint_32 iwidth, png_uint_32 iheight);
+    static bool allocateStorage(Image& image, png_uint_32 iwidth, png_uint_32 iheight);
 
     /** The actual method which saves a PNG image.
 
@@ -170,14 +198,6 @@ class PNGLibrary
                          png_uint_32 width, png_uint_32 height,
                          const VariantList& comments);
 
-    /**
-      Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
-      is resized as necessary to accommodate the data.
-
-      @param surface  The FBSurface into which to place the PNG data
-    */
-    void loadImagetoSurface(FBSurface& surface);
-
     /**
       Write PNG tEXt chunks to the image.
     */
@@ -25,6 +25,91 @@
 
 #include "RewindManager.hxx"
 
+namespace {
+  // A run of unchanged bytes shorter than this is included in a delta literal
+  constexpr uInt32 MIN_UNCHANGED_RUN = 4;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void putVarint(ByteArray& out, size_t value)
+  {
+    while(value >= 0x80)
+    {
+      out.push_back(uInt8(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(uInt8(value));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  size_t getVarint(const ByteArray& in, size_t& pos)
+  {
+    size_t value = 0;
+    for(uInt32 shift = 0; ; shift += 7)
+    {
+      const uInt8 b = in[pos++];
+      value |= size_t(b & 0x7f) << shift;
+      if(!(b & 0x80))
+        return value;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Encode 'state' as the difference to 'keyframe': the size of the state,
+  // followed by pairs of (number of unchanged bytes, number of changed bytes)
+  // with the changed bytes XORed with the keyframe
+  void encodeDelta(const ByteArray& keyframe, const ByteArray& state, ByteArray& delta)
+  {
+    const size_t size = state.size();
+    const auto changed = [&](size_t i) {
+      return state[i] != (i < keyframe.size() ? keyframe[i] : 0);
+    };
+
+    delta.clear();
+    putVarint(delta, size);
+
+    size_t i = 0;
+    while(i < size)
+    {
+      const size_t unchanged = i;
+      while(i < size && !changed(i)) ++i;
+      if(i == size)
+        break;
+
+      const size_t start = i;
+      size_t end = i;
+      while(i < size && i - end < MIN_UNCHANGED_RUN)
+        if(changed(i++))
+          end = i;
+
+      putVarint(delta, start - unchanged);
+      putVarint(delta, end - start);
+      for(size_t j = start; j < end; ++j)
+        delta.push_back(state[j] ^ (j < keyframe.size() ? keyframe[j] : 0));
+
+      i = end;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void decodeDelta(const ByteArray& keyframe, const ByteArray& delta, ByteArray& state)
+  {
+    size_t pos = 0;
+    const size_t size = getVarint(delta, pos);
+
+    state.assign(keyframe.begin(), keyframe.begin() + std::min(size, keyframe.size()));
+    state.resize(size, 0);
+
+    size_t i = 0;
+    while(pos < delta.size())
+    {
+      i += getVarint(delta, pos);
+      const size_t length = getVarint(delta, pos);
+      for(size_t j = 0; j < length; ++j)
+        state[i++] ^= delta[pos++];
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 RewindManager::RewindManager(OSystem& system, StateManager& statemgr)
   : myOSystem(system),
@@ -124,12 +209,19 @@ bool RewindManager::addState(const string& message, bool timeMachine)
   // This updates the 'current' iterator inside the list
   myStateList.addLast();
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  Serializer& s = myStateData;
 
   s.rewind();  // rewind Serializer internal buffers
   if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
   {
-    myStateSize = std::max(myStateSize, uInt32(s.size()));
+    const uInt32 size = uInt32(s.size());
+
+    myStateSize = std::max(myStateSize, size);
+    myStateBuffer.resize(size);
+    s.rewind();
+    s.getByteArray(myStateBuffer.data(), size);
+    storeLastState(myStateBuffer);
+
     state.message = message;
     state.cycles = myOSystem.console().tia().cycles();
     myLastTimeMachineAdd = timeMachine;
@@ -157,10 +249,6 @@ uInt32 RewindManager::rewindStates(uInt32 numStates)
         // ...except when the last state was added automatically,
         // because that already happened one interval before
         myLastTimeMachineAdd = false;
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -191,10 +279,6 @@ uInt32 RewindManager::unwindStates(uInt32 numStates)
       // Set internal current iterator to nextCycles state (forward in time),
       // since we will now process this state
       myStateList.moveToNext();
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -247,16 +331,13 @@ string RewindManager::saveAllStates()
     out.putShort(numStates);
     out.putInt(myStateSize);
 
-    unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(myStateSize);
     for (uInt32 i = 0; i < numStates; i++)
     {
       RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      // Rewind Serializer internal buffers
-      s.rewind();
-      // Save state
-      s.getByteArray(buffer.get(), myStateSize);
-      out.putByteArray(buffer.get(), myStateSize);
+      // Save state (all states are padded to the same size)
+      decodeState(myStateList.currentIter(), myStateBuffer);
+      myStateBuffer.resize(myStateSize, 0);
+      out.putByteArray(myStateBuffer.data(), myStateSize);
       out.putString(state.message);
       out.putLong(state.cycles);
 
@@ -302,7 +383,7 @@ string RewindManager::loadAllStates()
     numStates = in.getShort();
     myStateSize = in.getInt();
 
-    unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(myStateSize);
+    myStateBuffer.resize(myStateSize);
     for (uInt32 i = 0; i < numStates; i++)
     {
       if (myStateList.full())
@@ -312,13 +393,10 @@ string RewindManager::loadAllStates()
       // This updates the 'current' iterator inside the list
       myStateList.addLast();
       RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      // Rewind Serializer internal buffers
-      s.rewind();
 
       // Fill new state with saved values
-      in.getByteArray(buffer.get(), myStateSize);
-      s.putByteArray(buffer.get(), myStateSize);
+      in.getByteArray(myStateBuffer.data(), myStateSize);
+      storeLastState(myStateBuffer);
       state.message = in.getString();
       state.cycles = in.getLong();
     }
@@ -367,14 +445,99 @@ void RewindManager::compressStates()
     }
     --idx;
   }
-   myStateList.remove(removeIter); // remove
+  removeState(removeIter);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::storeLastState(const ByteArray& state)
+{
+  RewindState& last = myStateList.node(myStateList.last());
+  uInt32 distance = KEYFRAME_INTERVAL;
+  StateIter keyframe;
+
+  if(myStateList.size() > 1)
+  {
+    keyframe = findKeyframe(myStateList.previous(myStateList.last()), distance);
+    ++distance;
+  }
+
+  if(distance >= KEYFRAME_INTERVAL)
+  {
+    last.data = state;
+    last.keyframe = true;
+  }
+  else
+  {
+    encodeDelta(keyframe->data, state, myDeltaBuffer);
+
+    // Release the memory of states that were previously used as keyframes
+    if(last.data.capacity() > 2 * myDeltaBuffer.size())
+      last.data = ByteArray(myDeltaBuffer);
+    else
+      last.data = myDeltaBuffer;
+    last.keyframe = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::decodeState(StateIter it, ByteArray& state) const
+{
+  if(it->keyframe)
+    state = it->data;
+  else
+  {
+    uInt32 distance;
+    decodeDelta(findKeyframe(it, distance)->data, it->data, state);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindManager::StateIter RewindManager::findKeyframe(StateIter it, uInt32& distance) const
+{
+  // The first state of the list is always a keyframe
+  distance = 0;
+  while(!it->keyframe && it != myStateList.first())
+  {
+    it = myStateList.previous(it);
+    ++distance;
+  }
+  return it;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::removeState(StateIter it)
+{
+  StateIter next = myStateList.next(it);
+
+  if(it->keyframe && next != myStateList.cend() && !next->keyframe)
+  {
+    // Turn the next state into a keyframe...
+    RewindState& keyframe = myStateList.node(next);
+    decodeDelta(it->data, keyframe.data, myStateBuffer);
+    keyframe.data = myStateBuffer;
+    keyframe.keyframe = true;
+
+    // ...and encode the following deltas against it
+    for(++next; next != myStateList.cend() && !next->keyframe; ++next)
+    {
+      RewindState& state = myStateList.node(next);
+      decodeDelta(it->data, state.data, myStateBuffer);
+      encodeDelta(keyframe.data, myStateBuffer, state.data);
+    }
+  }
+  myStateList.remove(it);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
 {
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  Serializer& s = myStateData;
+
+  decodeState(myStateList.currentIter(), myStateBuffer);
+  s.rewind();  // rewind Serializer internal buffers
+  s.putByteArray(myStateBuffer.data(), uInt32(myStateBuffer.size()));
+  s.rewind();
 
   myStateManager.loadState(s);
   myOSystem.console().tia().loadDisplay(s);
@@ -22,6 +22,7 @@ class OSystem;
 class StateManager;
 
 #include "LinkedObjectPool.hxx"
+#include "Serializer.hxx"
 #include "bspf.hxx"
 
 /**
@@ -41,6 +42,11 @@ class StateManager;
   If the list is full, states are either removed at the beginning (compression
   off) or at selective positions (compression on).
 
+  To save memory, only every KEYFRAME_INTERVAL-th state is stored completely
+  (a keyframe).  The states in between are stored as the XOR difference to
+  their preceding keyframe, with unchanged bytes run-length encoded.  Since
+  consecutive states differ in only a few bytes, these deltas are tiny.
+
   @author  Stephen Anthony
 */
 class RewindManager
@@ -177,16 +183,22 @@ class RewindManager
     bool   myLastTimeMachineAdd;
     uInt32 myStateSize;
 
+    // Number of states between two keyframes (see above)
+    static constexpr uInt32 KEYFRAME_INTERVAL = 30;
+
     struct RewindState {
-      Serializer data;  // actual save state
+      ByteArray data;   // actual save state, complete or delta encoded
+      bool keyframe;    // is the state stored completely?
       string message;   // describes save state origin
       uInt64 cycles;    // cycles since emulation started
 
       // We do nothing on object instantiation or copy
       // The goal of LinkedObjectPool is to not do any allocations at all
-      RewindState() : cycles(0) { }
-      RewindState(const RewindState& rs) : cycles(rs.cycles) { }
-      RewindState& operator= (const RewindState& rs) { cycles = rs.cycles; return *this; }
+      RewindState() : keyframe(true), cycles(0) { }
+      RewindState(const RewindState& rs) : keyframe(rs.keyframe), cycles(rs.cycles) { }
+      RewindState& operator= (const RewindState& rs) {
+        keyframe = rs.keyframe; cycles = rs.cycles; return *this;
+      }
 
       // Output object info; used for debugging only
       friend ostream& operator<<(ostream& os, const RewindState& s) {
@@ -197,12 +209,43 @@ class RewindManager
     // The linked-list to store states (internally it takes care of reducing
     // frequent (de)-allocations)
     Common::LinkedObjectPool<RewindState> myStateList;
+    using StateIter = Common::LinkedObjectPool<RewindState>::const_iter;
+
+    // Scratch buffers for encoding and decoding states
+    Serializer myStateData;
+    ByteArray myStateBuffer, myDeltaBuffer;
 
     /**
       Remove a save state from the list
     */
     void compressStates();
 
+    /**
+      Store the given state data in the last state of the list, either as a
+      keyframe or as a delta to the preceding keyframe.
+    */
+    void storeLastState(const ByteArray& state);
+
+    /**
+      Reconstruct the complete data of the given state.
+    */
+    void decodeState(StateIter it, ByteArray& state) const;
+
+    /**
+      Find the keyframe that the given state depends on (the state itself if
+      it is a keyframe).
+
+      @param distance  Set to the number of states between both
+    */
+    StateIter findKeyframe(StateIter it, uInt32& distance) const;
+
+    /**
+      Remove the given state from the list.  If it is a keyframe, the
+      following state becomes a keyframe and the deltas depending on it
+      are re-encoded.
+    */
+    void removeState(StateIter it);
+
     /**
       Load the current state and get the message string for the rewind/unwind
 
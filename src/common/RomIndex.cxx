@@ -0,0 +1,223 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "MD5.hxx"
+#include "repository/KeyValueRepository.hxx"
+
+#include "RomIndex.hxx"
+
+constexpr char RomIndex::VERSION[];
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::RomIndex(shared_ptr<KeyValueRepository> repository)
+  : myRepository(repository)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::lookup(const FilesystemNode& node, Entry& entry)
+{
+  uInt64 size, modified;
+  if(!node.getFileInfo(size, modified))
+    return false;
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  load();
+
+  const auto iter = myRecords.find(node.getPath());
+  if(iter == myRecords.end() ||
+     iter->second.size != size || iter->second.modified != modified)
+    return false;
+
+  entry = iter->second.entry;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::update(const FilesystemNode& node, const Entry& entry)
+{
+  uInt64 size, modified;
+  if(entry.md5 == "" || !node.getFileInfo(size, modified))
+    return;
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  load();
+
+  Record& record = myRecords[node.getPath()];
+  if(record.size != size || record.modified != modified ||
+     record.entry.md5 != entry.md5)
+  {
+    record.size = size;
+    record.modified = modified;
+    record.entry = Entry();
+  }
+
+  // Nothing to do if the entry is already known
+  Entry& old = record.entry;
+  if(old.md5 == entry.md5 && (entry.type == "" || old.type == entry.type) &&
+     (entry.name == "" || old.name == entry.name))
+    return;
+
+  old.md5 = entry.md5;
+  if(entry.type != "")  old.type = entry.type;
+  if(entry.name != "")  old.name = entry.name;
+
+  myChanges[node.getPath()] = encode(record);
+  myRemovals.erase(node.getPath());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomIndex::md5(const FilesystemNode& node)
+{
+  Entry entry;
+  if(lookup(node, entry))
+    return entry.md5;
+
+  entry.md5 = MD5::hash(node);
+  update(node, entry);
+
+  return entry.md5;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::prune(const FilesystemNode& dir, const FSList& files)
+{
+  std::unordered_set<string> present;
+  for(const auto& file: files)
+    present.insert(file.getPath());
+
+  const string& dirPath = dir.getPath();
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  load();
+
+  for(auto iter = myRecords.begin(); iter != myRecords.end(); )
+  {
+    const string& path = iter->first;
+    if(inDirectory(path, dirPath) && present.find(path) == present.end())
+    {
+      myChanges.erase(path);
+      myRemovals.insert(path);
+      iter = myRecords.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::flush()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  if(myChanges.empty() && myRemovals.empty())
+    return;
+
+  if(!myChanges.empty())
+    myRepository->save(myChanges);
+  for(const auto& path: myRemovals)
+    myRepository->remove(path);
+
+  myChanges.clear();
+  myRemovals.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::load()
+{
+  if(myLoaded)
+    return;
+
+  myLoaded = true;
+  for(const auto& pair: myRepository->load())
+  {
+    Record record;
+    if(decode(pair.second.toString(), record))
+      myRecords[pair.first] = record;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::inDirectory(const string& path, const string& dir)
+{
+  if(dir.empty() || path.size() <= dir.size() ||
+     path.compare(0, dir.size(), dir) != 0)
+    return false;
+
+  // The directory path may or may not end with a separator; either way,
+  // the rest of the path must be a single name
+  const auto isSeparator = [](char c) { return c == '/' || c == '\\'; };
+  size_t pos = dir.size();
+  if(!isSeparator(dir.back()))
+  {
+    if(!isSeparator(path[pos]))
+      return false;
+    ++pos;
+  }
+
+  return pos < path.size() &&
+         std::none_of(path.begin() + pos, path.end(), isSeparator);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomIndex::encode(const Record& record)
+{
+  // The name comes last, since it may contain the separator
+  ostringstream buf;
+  buf << VERSION << '|' << record.size << '|' << record.modified << '|' << record.entry.md5
+      << '|' << record.entry.type << '|' << record.entry.name;
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::decode(const string& value, Record& record)
+{
+  string fields[5];
+  size_t pos = 0;
+  for(auto& field: fields)
+  {
+    size_t next = value.find('|', pos);
+    if(next == string::npos)
+      return false;
+
+    field = value.substr(pos, next - pos);
+    pos = next + 1;
+  }
+
+  // Records of other versions are ignored, and replaced when the file
+  // is seen again
+  if(fields[0] != VERSION)
+    return false;
+
+  try
+  {
+    record.size = std::stoull(fields[1]);
+    record.modified = std::stoull(fields[2]);
+  }
+  catch(const std::logic_error&)
+  {
+    return false;
+  }
+  record.entry.md5 = fields[3];
+  record.entry.type = fields[4];
+  record.entry.name = value.substr(pos);
+
+  return record.entry.md5 != "";
+}
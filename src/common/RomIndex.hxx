@@ -0,0 +1,136 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INDEX_HXX
+#define ROM_INDEX_HXX
+
+class KeyValueRepository;
+
+#include <mutex>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "FSNode.hxx"
+#include "Variant.hxx"
+#include "bspf.hxx"
+
+/**
+  An index of the ROM files seen so far, which maps the path of each file
+  to its MD5, detected bankswitch type and display name.  This avoids
+  re-reading and hashing all files each time a large ROM directory is
+  listed or audited.
+
+  An entry is only used as long as the size and the modification time of
+  the file are unchanged; entries of files which were deleted or renamed
+  are dropped by prune().  The index is kept in memory; changes are written
+  to the repository (the 'romindex' table of the settings database) in one
+  go by flush().  All methods may be called from any thread.
+*/
+class RomIndex
+{
+  public:
+    struct Entry {
+      string md5;
+      string type;  // The bankswitch type name, empty if not known
+      string name;  // The display name, empty if not known
+    };
+
+    explicit RomIndex(shared_ptr<KeyValueRepository> repository);
+
+    /**
+      Look up the entry for the given file.
+
+      @param node   The ROM file
+      @param entry  Receives the entry, if found
+
+      @return  True if a valid entry exists, false otherwise
+    */
+    bool lookup(const FilesystemNode& node, Entry& entry);
+
+    /**
+      Add or replace the entry for the given file.  Empty fields keep the
+      value of a previous (still valid) entry with the same MD5.
+
+      @param node   The ROM file
+      @param entry  The info about the ROM
+    */
+    void update(const FilesystemNode& node, const Entry& entry);
+
+    /**
+      Get the MD5 of the given file, from the index if possible; otherwise
+      the file is hashed and the result added to the index.
+
+      @param node  The ROM file
+
+      @return  The MD5, or the empty string if the file can't be read
+    */
+    string md5(const FilesystemNode& node);
+
+    /**
+      Remove the entries of the files in the given directory which are no
+      longer present.  Files in subdirectories are not affected.
+
+      @param dir    The directory
+      @param files  All files currently in the directory
+    */
+    void prune(const FilesystemNode& dir, const FSList& files);
+
+    /**
+      Write all changes since the last flush to the repository.
+    */
+    void flush();
+
+  private:
+    struct Record {
+      uInt64 size{0}, modified{0};
+      Entry entry;
+    };
+
+    // Load the repository, if not done yet; must be called with myMutex held
+    void load();
+
+    // Check if the path denotes a file directly in the directory
+    static bool inDirectory(const string& path, const string& dir);
+
+    static string encode(const Record& record);
+    static bool decode(const string& value, Record& record);
+
+    // The version of the record format; the records are only valid as long
+    // as the way the file info is obtained doesn't change either
+    static constexpr char VERSION[] = "2";
+
+  private:
+    shared_ptr<KeyValueRepository> myRepository;
+
+    std::unordered_map<string, Record> myRecords;
+    std::map<string, Variant> myChanges;
+    std::set<string> myRemovals;
+    bool myLoaded{false};
+
+    std::mutex myMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndex() = delete;
+    RomIndex(const RomIndex&) = delete;
+    RomIndex(RomIndex&&) = delete;
+    RomIndex& operator=(const RomIndex&) = delete;
+    RomIndex& operator=(RomIndex&&) = delete;
+};
+
+#endif
@@ -468,10 +468,10 @@ void ZipHandler::ZipFile::decompressDataType8(
   // Loop until we're done
   for(;;)
   {
-    // Read in the next chunk of data
+    // Read in the next chunk of data (leaving room for the dummy byte)
     uInt64 read_length = 0;
     bool success = readStream(myBuffer, offset,
-          std::min(input_remaining, uInt64(sizeof(myBuffer.get()))), read_length);
+          std::min(input_remaining, uInt64(DECOMPRESS_BUFSIZE - 1)), read_length);
     if(!success)
     {
       inflateEnd(&stream);
@@ -17,30 +17,63 @@
 
 #include "ConvolutionBuffer.hxx"
 
+#if defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(_M_X64)
+  #define CONVOLUTION_SSE
+  #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define CONVOLUTION_NEON
+  #include <arm_neon.h>
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ConvolutionBuffer::ConvolutionBuffer(uInt32 size)
   : myFirstIndex(0),
     mySize(size)
 {
-  myData = make_unique<float[]>(mySize);
-  memset(myData.get(), 0, mySize * sizeof(float));
+  myData = make_unique<float[]>(2 * mySize);
+  memset(myData.get(), 0, 2 * mySize * sizeof(float));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ConvolutionBuffer::shift(float nextValue)
 {
-  myData[myFirstIndex] = nextValue;
-  myFirstIndex = (myFirstIndex + 1) % mySize;
+  myData[myFirstIndex] = myData[myFirstIndex + mySize] = nextValue;
+  if (++myFirstIndex == mySize) myFirstIndex = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float ConvolutionBuffer::convoluteWith(float* kernel) const
+float ConvolutionBuffer::convoluteWith(const float* kernel) const
 {
+  const float* data = myData.get() + myFirstIndex;
+  uInt32 i = 0;
   float result = 0.;
 
-  for (uInt32 i = 0; i < mySize; ++i) {
-    result += kernel[i] * myData[(myFirstIndex + i) % mySize];
+#if defined(CONVOLUTION_SSE)
+  __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+
+  for (; i + 8 <= mySize; i += 8) {
+    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(kernel + i), _mm_loadu_ps(data + i)));
+    sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(kernel + i + 4), _mm_loadu_ps(data + i + 4)));
   }
 
+  float sums[4];
+  _mm_storeu_ps(sums, _mm_add_ps(sum0, sum1));
+  result = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#elif defined(CONVOLUTION_NEON)
+  float32x4_t sum0 = vdupq_n_f32(0.f), sum1 = vdupq_n_f32(0.f);
+
+  for (; i + 8 <= mySize; i += 8) {
+    sum0 = vmlaq_f32(sum0, vld1q_f32(kernel + i), vld1q_f32(data + i));
+    sum1 = vmlaq_f32(sum1, vld1q_f32(kernel + i + 4), vld1q_f32(data + i + 4));
+  }
+
+  const float32x4_t sum = vaddq_f32(sum0, sum1);
+  result = (vgetq_lane_f32(sum, 0) + vgetq_lane_f32(sum, 1)) +
+           (vgetq_lane_f32(sum, 2) + vgetq_lane_f32(sum, 3));
+#endif
+
+  for (; i < mySize; ++i)
+    result += kernel[i] * data[i];
+
   return result;
 }
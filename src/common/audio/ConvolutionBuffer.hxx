@@ -20,6 +20,11 @@
 
 #include "bspf.hxx"
 
+/**
+  A circular buffer of the last 'size' samples.  Every sample is stored twice
+  ('mirrored'), so the samples always form a contiguous window that can be
+  convoluted with a kernel without wrapping around.
+*/
 class ConvolutionBuffer
 {
   public:
@@ -28,10 +33,11 @@ class ConvolutionBuffer
 
     void shift(float nextValue);
 
-    float convoluteWith(float* kernel) const;
+    float convoluteWith(const float* kernel) const;
 
   private:
 
+    // 2 * mySize samples; the window starts at myFirstIndex
     unique_ptr<float[]> myData;
 
     uInt32 myFirstIndex;
@@ -148,7 +148,7 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   for (uInt32 i = 0; i < outputSamples; ++i) {
-    float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
+    const float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
     myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
 
     if (myFormatFrom.stereo) {
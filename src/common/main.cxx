@@ -70,7 +70,7 @@ void checkForCustomBaseDir(Settings::Options& options);
 
 /**
   Checks whether the commandline contains an argument corresponding to
-  starting a profile session.
+  starting a profile, batch or golden file session.
 */
 bool isProfilingRun(int ac, char* av[]);
 
@@ -151,7 +151,9 @@ void checkForCustomBaseDir(Settings::Options& options)
 bool isProfilingRun(int ac, char* av[]) {
   if (ac <= 1) return false;
 
-  return string(av[1]) == "-profile";
+  const string mode = av[1];
+
+  return mode == "-profile" || mode == "-batch" || mode == "-golden";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -15,6 +15,7 @@ MODULE_OBJS := \
 	src/common/PKeyboardHandler.o \
 	src/common/PNGLibrary.o \
 	src/common/RewindManager.o \
+	src/common/RomIndex.o \
 	src/common/SoundSDL2.o \
 	src/common/StateManager.o \
 	src/common/TimerManager.o \
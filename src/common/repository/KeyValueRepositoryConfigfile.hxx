@@ -32,6 +32,8 @@ class KeyValueRepositoryConfigfile : public KeyValueRepository
 
     void save(const string& key, const Variant& value) override {}
 
+    void remove(const string& key) override {}
+
   private:
 
     const string& myFilename;
@@ -90,6 +90,23 @@ void KeyValueRepositorySqlite::save(const string& key, const Variant& value)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositorySqlite::remove(const string& key)
+{
+  try {
+    myStmtDelete->reset();
+
+    (*myStmtDelete)
+      .bind(1, key.c_str())
+      .step();
+
+    myStmtDelete->reset();
+  }
+  catch (SqliteError err) {
+    Logger::log(err.message, 1);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void KeyValueRepositorySqlite::initialize()
 {
@@ -99,4 +116,5 @@ void KeyValueRepositorySqlite::initialize()
 
   myStmtInsert = make_unique<SqliteStatement>(myDb, "INSERT OR REPLACE INTO `" + myTableName + "` VALUES (?, ?)");
   myStmtSelect = make_unique<SqliteStatement>(myDb, "SELECT `key`, `VALUE` FROM `" + myTableName + "`");
+  myStmtDelete = make_unique<SqliteStatement>(myDb, "DELETE FROM `" + myTableName + "` WHERE `key` = ?");
 }
@@ -35,6 +35,8 @@ class KeyValueRepositorySqlite : public KeyValueRepository
 
     void save(const string& key, const Variant& value) override;
 
+    void remove(const string& key) override;
+
     void initialize();
 
   private:
@@ -44,6 +46,7 @@ class KeyValueRepositorySqlite : public KeyValueRepository
 
     unique_ptr<SqliteStatement> myStmtInsert;
     unique_ptr<SqliteStatement> myStmtSelect;
+    unique_ptr<SqliteStatement> myStmtDelete;
 
   private:
 
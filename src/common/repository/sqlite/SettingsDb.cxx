@@ -36,12 +36,16 @@ bool SettingsDb::initialize()
 
     mySettingsRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "settings");
     mySettingsRepository->initialize();
+
+    myRomIndexRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "romindex");
+    myRomIndexRepository->initialize();
   }
   catch (SqliteError err) {
     Logger::log("sqlite DB " + myDb->fileName() + " failed to initialize: " + err.message, 1);
 
     myDb.reset();
     mySettingsRepository.reset();
+    myRomIndexRepository.reset();
 
     return false;
   }
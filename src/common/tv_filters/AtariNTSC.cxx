@@ -18,6 +18,12 @@
 #include <thread>
 #include "AtariNTSC.hxx"
 
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#elif defined(ATARI_NTSC_SIMD)
+  #include <arm_neon.h>
+#endif
+
 // blitter related
 #ifndef restrict
   #if defined (__GNUC__)
@@ -71,18 +77,69 @@ void AtariNTSC::enableThreading(bool enable)
 {
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
   if(systemThreads <= 1)
-  {
-    myWorkerThreads = 0;
-    myTotalThreads  = 1;
-  }
+    startThreads(0);
   else
   {
     systemThreads = std::max(1u, std::min(4u, systemThreads - 1));
 
-    myWorkerThreads = systemThreads - 1;
-    myTotalThreads  = systemThreads;
+    startThreads(systemThreads - 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::startThreads(uInt32 workerThreads)
+{
+  stopThreads();
+
+  myWorkerThreads = workerThreads;
+  myTotalThreads  = workerThreads + 1;
+
+  myFrameNumber = 0;
+  myPendingWorkers = 0;
+  myQuitThreads = false;
+
+  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    myThreads.emplace_back(&AtariNTSC::workerThread, this, i+1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::stopThreads()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuitThreads = true;
+  }
+  myFrameStarted.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+  myThreads.clear();
+
+  myWorkerThreads = 0;
+  myTotalThreads  = 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::workerThread(uInt32 threadNum)
+{
+  uInt64 frameNumber = 0;
+
+  for(;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myFrameStarted.wait(lock, [&] { return myQuitThreads || myFrameNumber != frameNumber; });
+
+      if(myQuitThreads)
+        return;
+      frameNumber = myFrameNumber;
+    }
+
+    renderSlice(threadNum);
 
-    myThreads = make_unique<std::thread[]>(myWorkerThreads);
+    std::lock_guard<std::mutex> lock(myMutex);
+    if(--myPendingWorkers == 0)
+      myFrameFinished.notify_one();
   }
 }
 
@@ -90,28 +147,44 @@ void AtariNTSC::enableThreading(bool enable)
 void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
   void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+  myFrame = { atari_in, in_width, in_height, rgb_out, out_pitch, rgb_in };
+
+  // Wake up the threads...
+  if(myWorkerThreads > 0)
   {
-    myThreads[i] = std::thread([=] {
-    rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myPendingWorkers = myWorkerThreads;
+      ++myFrameNumber;
+    }
+    myFrameStarted.notify_all();
   }
   // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
+  renderSlice(0);
+  // ...and wait until they are done
+  if(myWorkerThreads > 0)
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+    myFrameFinished.wait(lock, [&] { return myPendingWorkers == 0; });
+  }
 
   // Copy phosphor values into out buffer
   if(rgb_in != nullptr)
     memcpy(rgb_out, rgb_in, in_height * out_pitch);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderSlice(uInt32 threadNum)
+{
+  const Frame& f = myFrame;
+
+  f.rgb_in == nullptr ?
+    renderThread(f.atari_in, f.in_width, f.in_height, myTotalThreads, threadNum,
+                 f.rgb_out, f.out_pitch) :
+    renderWithPhosphorThread(f.atari_in, f.in_width, f.in_height, myTotalThreads, threadNum,
+                             f.rgb_in, f.rgb_out, f.out_pitch);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
   const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
@@ -134,6 +207,12 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
 
     for(uInt32 n = chunk_count; n; --n)
     {
+    #ifdef ATARI_NTSC_SIMD
+      ATARI_NTSC_COLOR_IN(0, line_in[0])
+      uInt32 const* kernelxp = kernelx1;
+      ATARI_NTSC_COLOR_IN(1, line_in[1])
+      renderChunk(kernel0, kernel1, kernelx0, kernelx1, kernelxp, line_out);
+    #else
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0])
       ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
@@ -145,6 +224,7 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
       ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
       ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
       ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+    #endif
 
       line_in += 2;
       line_out += 7;
@@ -207,6 +287,12 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
 
     for(uInt32 n = chunk_count; n; --n)
     {
+    #ifdef ATARI_NTSC_SIMD
+      ATARI_NTSC_COLOR_IN(0, line_in[0])
+      uInt32 const* kernelxp = kernelx1;
+      ATARI_NTSC_COLOR_IN(1, line_in[1])
+      renderChunk(kernel0, kernel1, kernelx0, kernelx1, kernelxp, line_out);
+    #else
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0])
       ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
@@ -218,6 +304,7 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
       ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
       ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
       ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+    #endif
 
       line_in += 2;
       line_out += 7;
@@ -253,67 +340,76 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
 
     // Do phosphor mode (blend the resulting frames)
     // Note: The code assumes that AtariNTSC::outWidth(kTIAW) == outPitch == 565
-    for (uInt32 x = AtariNTSC::outWidth(in_width) / 8; x; --x)
-    {
-      // Store back into displayed frame buffer (for next frame)
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-    }
-    // finish final pixels
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-#if 0
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-#endif
+    // Store back into displayed frame buffer (for next frame)
+    myPhosphor.blend(out + bufofs, rgb_in + bufofs, outWidth(in_width));
+    bufofs += outWidth(in_width);
 
     atari_in += in_width;
     rgb_out = static_cast<char*>(rgb_out) + out_pitch;
   }
 }
 
+#ifdef ATARI_NTSC_SIMD
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline uInt32 AtariNTSC::getRGBPhosphor(const uInt32 c, const uInt32 p) const
+void AtariNTSC::renderChunk(const uInt32* kernel0, const uInt32* kernel1,
+  const uInt32* kernelx0, const uInt32* kernelx1, const uInt32* kernelxp,
+  uInt32* out)
 {
-#define TO_RGB(color, red, green, blue)   \
-    const uInt8 red   = uInt8(color >> 16); \
-    const uInt8 green = uInt8(color >> 8);\
-    const uInt8 blue  = uInt8(color);
-
-  TO_RGB(c, rc, gc, bc)
-  TO_RGB(p, rp, gp, bp)
-
-  // Mix current calculated frame with previous displayed frame
-  const uInt8 rn = myPhosphorPalette[rc][rp];
-  const uInt8 gn = myPhosphorPalette[gc][gp];
-  const uInt8 bn = myPhosphorPalette[bc][bp];
-
-  return (rn << 16) | (gn << 8) | bn;
+  // Same as ATARI_NTSC_RGB_OUT_8888 for pixels 0 - 3 and 4 - 7 (the eighth
+  // pixel is junk, and overwritten by the next chunk)
+#if defined(__SSE2__)
+  #define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+  const __m128i raw[2] = {
+    _mm_add_epi32(_mm_add_epi32(LOAD(kernel0), LOAD(kernelx1 + 17)),
+                  _mm_add_epi32(LOAD(kernelx0 + 7), LOAD(kernelxp + 24))),
+    _mm_add_epi32(_mm_add_epi32(LOAD(kernel0 + 4), LOAD(kernel1 + 14)),
+                  _mm_add_epi32(LOAD(kernelx0 + 11), LOAD(kernelx1 + 21)))
+  };
+  #undef LOAD
+
+  const __m128i mask = _mm_set1_epi32(atari_ntsc_clamp_mask),
+                add  = _mm_set1_epi32(atari_ntsc_clamp_add);
+  for(int i = 0; i < 2; ++i)
+  {
+    const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw[i], 9), mask);
+    __m128i clamp = _mm_sub_epi32(add, sub);
+    __m128i io = _mm_or_si128(raw[i], clamp);
+    clamp = _mm_sub_epi32(clamp, sub);
+    io = _mm_and_si128(io, clamp);
+
+    io = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(_mm_srli_epi32(io, 5), _mm_set1_epi32(0x00FF0000)),
+                   _mm_and_si128(_mm_srli_epi32(io, 3), _mm_set1_epi32(0x0000FF00))),
+      _mm_and_si128(_mm_srli_epi32(io, 1), _mm_set1_epi32(0x000000FF)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), io);
+  }
+#else
+  const uint32x4_t raw[2] = {
+    vaddq_u32(vaddq_u32(vld1q_u32(kernel0), vld1q_u32(kernelx1 + 17)),
+              vaddq_u32(vld1q_u32(kernelx0 + 7), vld1q_u32(kernelxp + 24))),
+    vaddq_u32(vaddq_u32(vld1q_u32(kernel0 + 4), vld1q_u32(kernel1 + 14)),
+              vaddq_u32(vld1q_u32(kernelx0 + 11), vld1q_u32(kernelx1 + 21)))
+  };
+
+  const uint32x4_t mask = vdupq_n_u32(atari_ntsc_clamp_mask),
+                   add  = vdupq_n_u32(atari_ntsc_clamp_add);
+  for(int i = 0; i < 2; ++i)
+  {
+    const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw[i], 9), mask);
+    uint32x4_t clamp = vsubq_u32(add, sub);
+    uint32x4_t io = vorrq_u32(raw[i], clamp);
+    clamp = vsubq_u32(clamp, sub);
+    io = vandq_u32(io, clamp);
+
+    io = vorrq_u32(
+      vorrq_u32(vandq_u32(vshrq_n_u32(io, 5), vdupq_n_u32(0x00FF0000)),
+                vandq_u32(vshrq_n_u32(io, 3), vdupq_n_u32(0x0000FF00))),
+      vandq_u32(vshrq_n_u32(io, 1), vdupq_n_u32(0x000000FF)));
+    vst1q_u32(out + i * 4, io);
+  }
+#endif
 }
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::init(init_t& impl, const Setup& setup)
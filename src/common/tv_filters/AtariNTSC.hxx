@@ -42,8 +42,17 @@
 
 #include <cmath>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "bspf.hxx"
+#include "PhosphorBlend.hxx"
+
+// The chunk renderer is vectorized when SSE2 or NEON are available at
+// compile time (always the case for x86_64 and aarch64)
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define ATARI_NTSC_SIMD
+#endif
 
 class AtariNTSC
 {
@@ -52,6 +61,7 @@ class AtariNTSC
 
     // By default, threading is turned off
     AtariNTSC() { enableThreading(false); }
+    ~AtariNTSC() { stopThreads(); }
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -82,13 +92,12 @@ class AtariNTSC
     void initialize(const Setup& setup, const uInt8* palette);
     void initializePalette(const uInt8* palette);
 
-    // Set up threading
+    // Set up threading; the rendering threads are started here and kept
+    // alive until threading is reconfigured
     void enableThreading(bool enable);
 
-    // Set phosphor palette, for use in Blargg + phosphor mode
-    void setPhosphorPalette(uInt8 palette[256][256]) {
-      memcpy(myPhosphorPalette, palette, 256 * 256);
-    }
+    // Set phosphor decay factor, for use in Blargg + phosphor mode
+    void setPhosphorFactor(float factor) { myPhosphor.setFactor(factor); }
 
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
     // palette colors.
@@ -112,21 +121,30 @@ class AtariNTSC
     }
 
   private:
+    // Start and stop the rendering threads
+    void startThreads(uInt32 workerThreads);
+    void stopThreads();
+
+    // Main loop of a worker thread: render its part of each frame
+    void workerThread(uInt32 threadNum);
+
+    // Render the part of the current frame assigned to a thread
+    void renderSlice(uInt32 threadNum);
+
     // Threaded rendering
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
     void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
 
-    /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c  RGB Color 1 (current frame)
-      @param cp RGB Color 2 (previous frame)
-
-      @return  Averaged value of the two RGB colors
-    */
-    uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
+  #ifdef ATARI_NTSC_SIMD
+    // Generate the 7 output pixels of a chunk from the kernels of the two
+    // input pixels, their predecessors and the kernel preceding those
+    // (kernelx1 before the second input pixel); also writes out[7]
+    static void renderChunk(const uInt32* kernel0, const uInt32* kernel1,
+      const uInt32* kernelx0, const uInt32* kernelx1, const uInt32* kernelxp,
+      uInt32* out);
+  #endif
 
   private:
     static constexpr Int32
@@ -163,12 +181,31 @@ class AtariNTSC
     #define LUMA_CUTOFF 0.20f
 
     uInt32 myColorTable[palette_size][entry_size];
-    uInt8 myPhosphorPalette[256][256];
+    PhosphorBlend myPhosphor;
 
     // Rendering threads
-    unique_ptr<std::thread[]> myThreads;
+    vector<std::thread> myThreads;
     // Number of rendering and total threads
-    uInt32 myWorkerThreads, myTotalThreads;
+    uInt32 myWorkerThreads{0}, myTotalThreads{1};
+
+    // The frame currently being rendered
+    struct Frame {
+      const uInt8* atari_in;
+      uInt32 in_width, in_height;
+      void* rgb_out;
+      uInt32 out_pitch;
+      uInt32* rgb_in;
+    };
+    Frame myFrame;
+
+    // A new frame is announced to the worker threads by incrementing the
+    // frame number; each worker decrements the number of pending workers
+    // once it has finished its part
+    std::mutex myMutex;
+    std::condition_variable myFrameStarted, myFrameFinished;
+    uInt64 myFrameNumber{0};
+    uInt32 myPendingWorkers{0};
+    bool myQuitThreads{false};
 
     struct init_t
     {
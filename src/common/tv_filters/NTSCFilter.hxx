@@ -72,8 +72,8 @@ class NTSCFilter
       myNTSC.initializePalette(myTIAPalette);
     }
 
-    inline void setPhosphorPalette(uInt8 palette[256][256]) {
-      myNTSC.setPhosphorPalette(palette);
+    inline void setPhosphorFactor(float factor) {
+      myNTSC.setPhosphorFactor(factor);
     }
 
     // The following are meant to be used strictly for toggling from the GUI
@@ -0,0 +1,257 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "PhosphorBlend.hxx"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define PHOSPHOR_X86
+  #include <immintrin.h>
+
+  #define TARGET_SSE2 __attribute__((target("sse2")))
+  #define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define PHOSPHOR_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace {
+  using BlendFunction = void (*)(const uInt32*, uInt32*, uInt32, float, const uInt8*);
+  using AverageFunction = void (*)(const uInt32*, const uInt32*, uInt32*, uInt32);
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  inline uInt32 blendPixel(uInt32 c, uInt32 p, const uInt8* decay)
+  {
+    // Use maximum of current and decayed previous values
+    const uInt32 r = std::max((c >> 16) & 0xff, uInt32(decay[(p >> 16) & 0xff]));
+    const uInt32 g = std::max((c >> 8) & 0xff, uInt32(decay[(p >> 8) & 0xff]));
+    const uInt32 b = std::max(c & 0xff, uInt32(decay[p & 0xff]));
+
+    return (r << 16) | (g << 8) | b;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  inline uInt32 averagePixel(uInt32 a, uInt32 b)
+  {
+    // Per channel (a + b) / 2, without overflowing into the next channel
+    return ((a & b) + (((a ^ b) >> 1) & 0x7f7f7f7f)) & 0x00ffffff;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void blendScalar(const uInt32* current, uInt32* previous, uInt32 count,
+                   float, const uInt8* decay)
+  {
+    for(uInt32 i = 0; i < count; ++i)
+      previous[i] = blendPixel(current[i], previous[i], decay);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void averageScalar(const uInt32* a, const uInt32* b, uInt32* out, uInt32 count)
+  {
+    for(uInt32 i = 0; i < count; ++i)
+      out[i] = averagePixel(a[i], b[i]);
+  }
+
+#ifdef PHOSPHOR_X86
+  // The decayed values are calculated exactly like the scalar table entries:
+  // the channel value is converted to float, multiplied and truncated
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  TARGET_SSE2 inline __m128i decaySSE2(__m128i channels, __m128 factor)
+  {
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(channels), factor));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  TARGET_SSE2 void blendSSE2(const uInt32* current, uInt32* previous, uInt32 count,
+                             float factor, const uInt8* decay)
+  {
+    const __m128 f = _mm_set1_ps(factor);
+    const __m128i zero = _mm_setzero_si128(), rgb = _mm_set1_epi32(0x00ffffff);
+
+    for(; count >= 4; count -= 4, current += 4, previous += 4)
+    {
+      const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+      const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous));
+
+      const __m128i lo = _mm_unpacklo_epi8(p, zero), hi = _mm_unpackhi_epi8(p, zero);
+      const __m128i d = _mm_packus_epi16(
+        _mm_packs_epi32(decaySSE2(_mm_unpacklo_epi16(lo, zero), f),
+                        decaySSE2(_mm_unpackhi_epi16(lo, zero), f)),
+        _mm_packs_epi32(decaySSE2(_mm_unpacklo_epi16(hi, zero), f),
+                        decaySSE2(_mm_unpackhi_epi16(hi, zero), f)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(previous),
+                       _mm_and_si128(_mm_max_epu8(c, d), rgb));
+    }
+    blendScalar(current, previous, count, factor, decay);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  TARGET_AVX2 inline __m256i decayAVX2(__m256i channels, __m256 factor)
+  {
+    return _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(channels), factor));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  TARGET_AVX2 void blendAVX2(const uInt32* current, uInt32* previous, uInt32 count,
+                             float factor, const uInt8* decay)
+  {
+    const __m256 f = _mm256_set1_ps(factor);
+    const __m256i zero = _mm256_setzero_si256(), rgb = _mm256_set1_epi32(0x00ffffff);
+
+    // The unpack and pack instructions work within 128 bit lanes, so the
+    // pixels end up in their original order
+    for(; count >= 8; count -= 8, current += 8, previous += 8)
+    {
+      const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+      const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous));
+
+      const __m256i lo = _mm256_unpacklo_epi8(p, zero), hi = _mm256_unpackhi_epi8(p, zero);
+      const __m256i d = _mm256_packus_epi16(
+        _mm256_packs_epi32(decayAVX2(_mm256_unpacklo_epi16(lo, zero), f),
+                           decayAVX2(_mm256_unpackhi_epi16(lo, zero), f)),
+        _mm256_packs_epi32(decayAVX2(_mm256_unpacklo_epi16(hi, zero), f),
+                           decayAVX2(_mm256_unpackhi_epi16(hi, zero), f)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(previous),
+                          _mm256_and_si256(_mm256_max_epu8(c, d), rgb));
+    }
+    blendScalar(current, previous, count, factor, decay);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  TARGET_SSE2 void averageSSE2(const uInt32* a, const uInt32* b, uInt32* out, uInt32 count)
+  {
+    const __m128i one = _mm_set1_epi8(1), rgb = _mm_set1_epi32(0x00ffffff);
+
+    for(; count >= 4; count -= 4, a += 4, b += 4, out += 4)
+    {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+      // _mm_avg_epu8 rounds up, so correct the odd sums
+      const __m128i avg = _mm_sub_epi8(_mm_avg_epu8(va, vb),
+                                       _mm_and_si128(_mm_xor_si128(va, vb), one));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_and_si128(avg, rgb));
+    }
+    averageScalar(a, b, out, count);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  BlendFunction selectBlend()
+  {
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))  return blendAVX2;
+    if(__builtin_cpu_supports("sse2"))  return blendSSE2;
+    return blendScalar;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  AverageFunction selectAverage()
+  {
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse2"))  return averageSSE2;
+    return averageScalar;
+  }
+
+#elif defined(PHOSPHOR_NEON)
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  inline uint16x8_t decayNEON(uint16x8_t channels, float32x4_t factor)
+  {
+    const uint32x4_t lo = vcvtq_u32_f32(vmulq_f32(
+      vcvtq_f32_u32(vmovl_u16(vget_low_u16(channels))), factor));
+    const uint32x4_t hi = vcvtq_u32_f32(vmulq_f32(
+      vcvtq_f32_u32(vmovl_u16(vget_high_u16(channels))), factor));
+
+    return vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void blendNEON(const uInt32* current, uInt32* previous, uInt32 count,
+                 float factor, const uInt8* decay)
+  {
+    const float32x4_t f = vdupq_n_f32(factor);
+    const uint32x4_t rgb = vdupq_n_u32(0x00ffffff);
+
+    for(; count >= 4; count -= 4, current += 4, previous += 4)
+    {
+      const uint8x16_t c = vreinterpretq_u8_u32(vld1q_u32(current));
+      const uint8x16_t p = vreinterpretq_u8_u32(vld1q_u32(previous));
+
+      const uint8x16_t d = vcombine_u8(
+        vmovn_u16(decayNEON(vmovl_u8(vget_low_u8(p)), f)),
+        vmovn_u16(decayNEON(vmovl_u8(vget_high_u8(p)), f)));
+
+      vst1q_u32(previous, vandq_u32(vreinterpretq_u32_u8(vmaxq_u8(c, d)), rgb));
+    }
+    blendScalar(current, previous, count, factor, decay);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void averageNEON(const uInt32* a, const uInt32* b, uInt32* out, uInt32 count)
+  {
+    const uint32x4_t rgb = vdupq_n_u32(0x00ffffff);
+
+    for(; count >= 4; count -= 4, a += 4, b += 4, out += 4)
+    {
+      const uint8x16_t avg = vhaddq_u8(vreinterpretq_u8_u32(vld1q_u32(a)),
+                                       vreinterpretq_u8_u32(vld1q_u32(b)));
+      vst1q_u32(out, vandq_u32(vreinterpretq_u32_u8(avg), rgb));
+    }
+    averageScalar(a, b, out, count);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  BlendFunction selectBlend()     { return blendNEON;   }
+  AverageFunction selectAverage() { return averageNEON; }
+
+#else
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  BlendFunction selectBlend()     { return blendScalar;   }
+  AverageFunction selectAverage() { return averageScalar; }
+#endif
+
+  const BlendFunction blendRow = selectBlend();
+  const AverageFunction averageRow = selectAverage();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PhosphorBlend::PhosphorBlend()
+{
+  setFactor(0.60f);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorBlend::setFactor(float factor)
+{
+  myFactor = factor;
+
+  for(uInt32 i = 0; i < 256; ++i)
+    myDecay[i] = uInt8(uInt8(i) * myFactor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorBlend::blend(const uInt32* current, uInt32* previous, uInt32 count) const
+{
+  blendRow(current, previous, count, myFactor, myDecay);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorBlend::average(const uInt32* a, const uInt32* b, uInt32* out, uInt32 count)
+{
+  averageRow(a, b, out, count);
+}
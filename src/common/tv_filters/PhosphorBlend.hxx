@@ -0,0 +1,74 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef PHOSPHOR_BLEND_HXX
+#define PHOSPHOR_BLEND_HXX
+
+#include "bspf.hxx"
+
+/**
+  Blends rows of RGB pixels for the 'phosphor' effect (aka reduced flicker
+  on 30Hz screens).  Each color channel of the previous frame decays by a
+  constant factor, and is raised to the value of the current frame if that
+  is brighter.
+
+  SSE2 and AVX2 (selected at runtime) and NEON implementations are used where
+  available; they produce exactly the same results as the scalar code.
+*/
+class PhosphorBlend
+{
+  public:
+    PhosphorBlend();
+
+    /**
+      Set the factor (0.0 - 1.0) the previous frame decays with.
+    */
+    void setFactor(float factor);
+
+    /**
+      Blend a row of pixels of the current frame into the previous frame;
+      for each channel, previous = max(current, previous * factor).
+
+      @param current   The pixels of the current frame
+      @param previous  The pixels of the previous frame, replaced by the result
+      @param count     The number of pixels
+    */
+    void blend(const uInt32* current, uInt32* previous, uInt32 count) const;
+
+    /**
+      Average two rows of pixels (50:50, rounded down) for each channel.
+
+      @param a, b   The pixels to average
+      @param out    The destination of the averaged pixels
+      @param count  The number of pixels
+    */
+    static void average(const uInt32* a, const uInt32* b, uInt32* out, uInt32 count);
+
+  private:
+    // The decay factor, and the resulting decayed value of each channel value
+    float myFactor;
+    uInt8 myDecay[256];
+
+  private:
+    // Following constructors and assignment operators not supported
+    PhosphorBlend(const PhosphorBlend&) = delete;
+    PhosphorBlend(PhosphorBlend&&) = delete;
+    PhosphorBlend& operator=(const PhosphorBlend&) = delete;
+    PhosphorBlend& operator=(PhosphorBlend&&) = delete;
+};
+
+#endif
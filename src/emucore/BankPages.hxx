@@ -0,0 +1,108 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BANK_PAGES_HXX
+#define BANK_PAGES_HXX
+
+#include "bspf.hxx"
+#include "Device.hxx"
+#include "System.hxx"
+
+/**
+  The page accessing methods of all banks of a bankswitched segment of the
+  cartridge address space.  They are built once when the cartridge is
+  installed, so that switching a bank only copies the prebuilt pages of the
+  bank into the system, instead of setting them up page by page.
+
+  Bank 'n' starts at offset n * BANK_SIZE of the ROM image, and is mapped
+  into a segment of the same size.  A segment can start with pages which
+  aren't bankswitched (eg. for extra RAM), and the pages containing the
+  hotspots are always accessed through the cartridge's peek() method, so
+  that it can react to them.
+
+  @tparam BANK_SIZE  The size of a bank (and segment) in bytes
+*/
+template<uInt16 BANK_SIZE>
+class BankPages
+{
+  static_assert((BANK_SIZE & System::PAGE_MASK) == 0,
+                "Bank size must be a multiple of the page size");
+
+  public:
+    BankPages() : myBegin(0), myPages(0) { }
+
+    /**
+      Build the page accessing methods for all banks.
+
+      @param device      The cartridge the pages belong to
+      @param image       The ROM image
+      @param codeAccess  The code access flags of the ROM image
+      @param banks       The number of banks
+      @param begin       The offset of the first bankswitched page in a bank
+      @param hotspot     The offset of the first hotspot in a bank; all
+                         following pages are accessed through peek()
+    */
+    void create(Device& device, uInt8* image, uInt8* codeAccess, uInt16 banks,
+                uInt16 begin = 0, uInt16 hotspot = BANK_SIZE)
+    {
+      myBegin = begin;
+      myPages = (BANK_SIZE - begin) >> System::PAGE_SHIFT;
+      myTable.assign(banks * myPages,
+                     System::PageAccess(&device, System::PageAccessType::READ));
+
+      System::PageAccess* access = myTable.data();
+      for(uInt32 bank = 0; bank < banks; ++bank)
+        for(uInt32 addr = begin; addr < BANK_SIZE; addr += System::PAGE_SIZE)
+        {
+          uInt32 offset = bank * BANK_SIZE + addr;
+
+          if(addr < (hotspot & ~System::PAGE_MASK))
+            access->directPeekBase = &image[offset];
+          access->codeAccessBase = &codeAccess[offset];
+          ++access;
+        }
+    }
+
+    /**
+      Map a bank into the segment starting at the given address.
+
+      @param system   The system to map the bank into
+      @param segment  The start address of the segment
+      @param bank     The bank to map
+    */
+    void map(System& system, uInt16 segment, uInt16 bank) const
+    {
+      system.setPageAccess(segment + myBegin, &myTable[bank * myPages], myPages);
+    }
+
+  private:
+    // Offset of the first bankswitched page, and number of pages of a bank
+    uInt16 myBegin;
+    uInt16 myPages;
+
+    // The page accessing methods of all banks, one bank after another
+    vector<System::PageAccess> myTable;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BankPages(const BankPages&) = delete;
+    BankPages(BankPages&&) = delete;
+    BankPages& operator=(const BankPages&) = delete;
+    BankPages& operator=(BankPages&&) = delete;
+};
+
+#endif
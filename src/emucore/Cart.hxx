@@ -201,6 +201,12 @@ class Cartridge : public Device
     */
     virtual uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) { return 0; }
 
+    /**
+      Get the number of ARM cycles run so far, as estimated by the
+      Thumbulator, for carts with an ARM processor (0 for all others).
+    */
+    virtual uInt64 thumbCycles() const { return 0; }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get optional debugger widget responsible for displaying info about the cart.
@@ -47,6 +47,9 @@ void Cartridge3F::install(System& system)
 {
   mySystem = &system;
 
+  // Build the page accessing methods of all banks of the first segment
+  myBankPages.create(*this, myImage.get(), myCodeAccessBase.get(), bankCount());
+
   System::PageAccess access(this, System::PageAccessType::READWRITE);
 
   // The hotspot ($3F) is in TIA address space, so we claim it here
@@ -109,18 +112,9 @@ bool Cartridge3F::bank(uInt16 bank)
     myCurrentBank = bank % (mySize >> 11);
   }
 
-  uInt32 offset = myCurrentBank << 11;
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
-
   // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  myBankPages.map(*mySystem, 0x1000, myCurrentBank);
+
   return myBankChanged = true;
 }
 
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "BankPages.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "Cart3FWidget.hxx"
 #endif
@@ -165,6 +166,9 @@ class Cartridge3F : public Cartridge
     // Indicates which bank is currently active for the first segment
     uInt16 myCurrentBank;
 
+    // The page accessing methods of all banks
+    BankPages<2048> myBankPages;
+
   private:
     // Following constructors and assignment operators not supported
     Cartridge3F() = delete;
@@ -78,6 +78,10 @@ void CartridgeAR::install(System& system)
 {
   mySystem = &system;
 
+  // The write timing of the Supercharger depends on the number of distinct
+  // accesses since the data hold register was set
+  mySystem->m6502().trackDistinctAccesses(true);
+
   // Map all of the accesses to call peek and poke (we don't yet indicate RAM areas)
   System::PageAccess access(this, System::PageAccessType::READ);
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
@@ -145,6 +145,11 @@ class CartridgeBUS : public Cartridge
    */
   uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) override;
 
+    /**
+      Get the number of ARM cycles run so far.
+    */
+    uInt64 thumbCycles() const override;
+
 
   #ifdef DEBUGGER_SUPPORT
     /**
@@ -43,6 +43,10 @@ void CartridgeDF::install(System& system)
 {
   mySystem = &system;
 
+  // Build the page accessing methods of all banks
+  myBankPages.create(*this, myImage, myCodeAccessBase.get(), bankCount(),
+                     0x0000, 0x0FC0);
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -79,24 +83,9 @@ bool CartridgeDF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PageAccessType::READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FC0 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the pages of the bank, including the hot spots
+  myBankPages.map(*mySystem, 0x1000, bank);
 
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < (0x1FC0U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
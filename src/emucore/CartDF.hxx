@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "BankPages.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartDFWidget.hxx"
 #endif
@@ -157,6 +158,9 @@ class CartridgeDF : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt32 myBankOffset;
 
+    // The page accessing methods of all banks
+    BankPages<4096> myBankPages;
+
 private:
     // Following constructors and assignment operators not supported
     CartridgeDF() = delete;
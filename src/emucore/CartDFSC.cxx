@@ -65,6 +65,10 @@ void CartridgeDFSC::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Build the page accessing methods of all banks
+  myBankPages.create(*this, myImage, myCodeAccessBase.get(), bankCount(),
+                     0x0100, 0x0FC0);
+
   // Install pages for the startup bank
   bank(startBank());
 }
@@ -110,24 +114,9 @@ bool CartridgeDFSC::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PageAccessType::READ);
+  // Map the pages of the bank, including the hot spots
+  myBankPages.map(*mySystem, 0x1000, bank);
 
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FC0 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1100; addr < (0x1FC0U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
   return myBankChanged = true;
 }
 
@@ -636,6 +636,12 @@ const uInt8* CartridgeDPCPlus::getImage(uInt32& size) const
   return myImage + (32768u - mySize);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 CartridgeDPCPlus::thumbCycles() const
+{
+  return myThumbEmulator->totalCycles();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeDPCPlus::save(Serializer& out) const
 {
@@ -140,6 +140,11 @@ class CartridgeDPCPlus : public Cartridge
     */
     string name() const override { return "CartridgeDPC+"; }
 
+    /**
+      Get the number of ARM cycles run so far.
+    */
+    uInt64 thumbCycles() const override;
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
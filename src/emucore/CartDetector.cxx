@@ -87,7 +87,7 @@ unique_ptr<Cartridge> CartDetector::create(const FilesystemNode& file,
   // If we ask for extended info, always do an autodetect
   if(type == Bankswitch::Type::_AUTO || settings.getBool("rominfo"))
   {
-    detectedType = autodetectType(image, size);
+    detectedType = autodetectType(image.get(), size);
     if(type != Bankswitch::Type::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -228,14 +228,51 @@ CartDetector::createFromMultiCart(const ByteBuffer& image, uInt32& size,
   // Move to the next game the next time this ROM is loaded
   settings.setValue("romloadcount", (i+1)%numroms);
 
-  if(size <= 2048)       type = Bankswitch::Type::_2K;
-  else if(size == 4096)  type = Bankswitch::Type::_4K;
-  else if(size == 8192)  type = Bankswitch::Type::_F8;
-  else  /* default */    type = Bankswitch::Type::_4K;
+  type = multiCartSliceType(size);
 
   return createFromImage(slice, size, type, md5, settings);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<Cartridge> CartDetector::clone(const Cartridge& cart,
+    const string& md5, Settings& settings)
+{
+  uInt32 size = 0;
+  const uInt8* image = cart.getImage(size);
+
+  ByteBuffer copy = make_unique<uInt8[]>(size);
+  memcpy(copy.get(), image, size);
+
+  // A multicart only holds the slice that was selected when it was created
+  Bankswitch::Type type = Bankswitch::nameToType(cart.detectedType());
+  switch(type)
+  {
+    case Bankswitch::Type::_2IN1:
+    case Bankswitch::Type::_4IN1:
+    case Bankswitch::Type::_8IN1:
+    case Bankswitch::Type::_16IN1:
+    case Bankswitch::Type::_32IN1:
+    case Bankswitch::Type::_64IN1:
+    case Bankswitch::Type::_128IN1:
+      type = multiCartSliceType(size);
+      break;
+
+    default:
+      break;
+  }
+
+  return createFromImage(copy, size, type, md5, settings);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Bankswitch::Type CartDetector::multiCartSliceType(uInt32 size)
+{
+  if(size <= 2048)       return Bankswitch::Type::_2K;
+  else if(size == 4096)  return Bankswitch::Type::_4K;
+  else if(size == 8192)  return Bankswitch::Type::_F8;
+  else  /* default */    return Bankswitch::Type::_4K;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge>
 CartDetector::createFromImage(const ByteBuffer& image, uInt32 size, Bankswitch::Type type,
@@ -334,7 +371,7 @@ CartDetector::createFromImage(const ByteBuffer& image, uInt32 size, Bankswitch::
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, uInt32 size)
+Bankswitch::Type CartDetector::autodetectType(const uInt8* image, uInt32 size)
 {
   // Guess type based on size
   Bankswitch::Type type = Bankswitch::Type::_AUTO;
@@ -352,7 +389,7 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, uInt32 si
     type = Bankswitch::Type::_2K;
   }
   else if((size == 2048) ||
-          (size == 4096 && memcmp(image.get(), image.get() + 2048, 2048) == 0))
+          (size == 4096 && memcmp(image, image + 2048, 2048) == 0))
   {
     type = isProbablyCV(image, size) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
   }
@@ -372,12 +409,12 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, uInt32 si
       { 0x8D, 0xF9, 0x1F },  // STA $1FF9
       { 0x8D, 0xF9, 0xFF }   // STA $FFF9
     };
-    bool f8 = searchForBytes(image.get(), size, signature[0], 3, 2) ||
-              searchForBytes(image.get(), size, signature[1], 3, 2);
+    bool f8 = searchForBytes(image, size, signature[0], 3, 2) ||
+              searchForBytes(image, size, signature[1], 3, 2);
 
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F8SC;
-    else if(memcmp(image.get(), image.get() + 4096, 4096) == 0)
+    else if(memcmp(image, image + 4096, 4096) == 0)
       type = Bankswitch::Type::_4K;
     else if(isProbablyE0(image, size))
       type = Bankswitch::Type::_E0;
@@ -551,11 +588,11 @@ bool CartDetector::searchForBytes(const uInt8* image, uInt32 imagesize,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySC(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablySC(const uInt8* image, uInt32 size)
 {
   // We assume a Superchip cart repeats the first 128 bytes for the second
   // 128 bytes in the RAM area, which is the first 256 bytes of each 4K bank
-  const uInt8* ptr = image.get();
+  const uInt8* ptr = image;
   while(size)
   {
     if(memcmp(ptr, ptr + 128, 128) != 0)
@@ -568,7 +605,7 @@ bool CartDetector::isProbablySC(const ByteBuffer& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyARM(const uInt8* image, uInt32 size)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
@@ -576,14 +613,14 @@ bool CartDetector::isProbablyARM(const ByteBuffer& image, uInt32 size)
     { 0xA0, 0xC1, 0x1F, 0xE0 },
     { 0x00, 0x80, 0x02, 0xE0 }
   };
-  if(searchForBytes(image.get(), std::min(size, 1024u), signature[0], 4, 1))
+  if(searchForBytes(image, std::min(size, 1024u), signature[0], 4, 1))
     return true;
   else
-    return searchForBytes(image.get(), std::min(size, 1024u), signature[1], 4, 1);
+    return searchForBytes(image, std::min(size, 1024u), signature[1], 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably0840(const uInt8* image, uInt32 size)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
@@ -593,7 +630,7 @@ bool CartDetector::isProbably0840(const ByteBuffer& image, uInt32 size)
     { 0x2C, 0x00, 0x08 }   // BIT $0800
   };
   for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature1[i], 3, 2))
+    if(searchForBytes(image, size, signature1[i], 3, 2))
       return true;
 
   uInt8 signature2[2][4] = {
@@ -601,43 +638,43 @@ bool CartDetector::isProbably0840(const ByteBuffer& image, uInt32 size)
     { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
   };
   for(uInt32 i = 0; i < 2; ++i)
-    if(searchForBytes(image.get(), size, signature2[i], 4, 2))
+    if(searchForBytes(image, size, signature2[i], 4, 2))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably3E(const uInt8* image, uInt32 size)
 {
   // 3E cart bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', commonly followed by an
   // immediate mode LDA
   uInt8 signature[] = { 0x85, 0x3E, 0xA9, 0x00 };  // STA $3E; LDA #$00
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return searchForBytes(image, size, signature, 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably3EPlus(const uInt8* image, uInt32 size)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
   uInt8 tj3e[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image.get(), size, tj3e, 4, 1);
+  return searchForBytes(image, size, tj3e, 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably3F(const uInt8* image, uInt32 size)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
   uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image.get(), size, signature, 2, 2);
+  return searchForBytes(image, size, signature, 2, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4A50(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably4A50(const uInt8* image, uInt32 size)
 {
   // 4A50 carts store address $4A50 at the NMI vector, which
   // in this scheme is always in the last page of ROM at
@@ -655,7 +692,7 @@ bool CartDetector::isProbably4A50(const ByteBuffer& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4KSC(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbably4KSC(const uInt8* image, uInt32 size)
 {
   // We check if the first 256 bytes are identical *and* if there's
   // an "SC" signature for one of our larger SC types at 1FFA.
@@ -672,19 +709,19 @@ bool CartDetector::isProbably4KSC(const ByteBuffer& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBF(const ByteBuffer& image, uInt32 size,
+bool CartDetector::isProbablyBF(const uInt8* image, uInt32 size,
                                 Bankswitch::Type& type)
 {
   // BF carts store strings 'BFBF' and 'BFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 bf[]   = { 'B', 'F', 'B', 'F' };
   uInt8 bfsc[] = { 'B', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, bf, 4, 1))
+  if(searchForBytes(image+size-8, 8, bf, 4, 1))
   {
     type = Bankswitch::Type::_BF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, bfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, bfsc, 4, 1))
   {
     type = Bankswitch::Type::_BFSC;
     return true;
@@ -694,34 +731,34 @@ bool CartDetector::isProbablyBF(const ByteBuffer& image, uInt32 size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyBUS(const uInt8* image, uInt32 size)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
   uInt8 bus[] = { 'B', 'U', 'S'};
-  return searchForBytes(image.get(), size, bus, 3, 2);
+  return searchForBytes(image, size, bus, 3, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyCDF(const uInt8* image, uInt32 size)
 {
   // CDF ARM code has 3 occurrences of the string CDF
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
   uInt8 cdf[] = { 'C', 'D', 'F' };
-  return searchForBytes(image.get(), size, cdf, 3, 3);
+  return searchForBytes(image, size, cdf, 3, 3);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyCTY(const uInt8* image, uInt32 size)
 {
   uInt8 lenin[] = { 'L', 'E', 'N', 'I', 'N' };
-  return searchForBytes(image.get(), size, lenin, 5, 1);
+  return searchForBytes(image, size, lenin, 5, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyCV(const uInt8* image, uInt32 size)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
   // These signatures are attributed to the MESS project
@@ -729,32 +766,32 @@ bool CartDetector::isProbablyCV(const ByteBuffer& image, uInt32 size)
     { 0x9D, 0xFF, 0xF3 },  // STA $F3FF.X
     { 0x99, 0x00, 0xF4 }   // STA $F400.Y
   };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
+  if(searchForBytes(image, size, signature[0], 3, 1))
     return true;
   else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+    return searchForBytes(image, size, signature[1], 3, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCVPlus(const ByteBuffer& image, uInt32)
+bool CartDetector::isProbablyCVPlus(const uInt8* image, uInt32)
 {
   // CV+ cart is identified key 'commavidplus' @ $04 in the ROM
   // We inspect only this area to speed up the search
   uInt8 cvp[12] = { 'c', 'o', 'm', 'm', 'a', 'v', 'i', 'd',
                     'p', 'l', 'u', 's' };
-  return searchForBytes(image.get()+4, 24, cvp, 12, 1);
+  return searchForBytes(image+4, 24, cvp, 12, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDASH(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyDASH(const uInt8* image, uInt32 size)
 {
   // DASH cart is identified key 'TJAD' in the ROM
   uInt8 tjad[] = { 'T', 'J', 'A', 'D' };
-  return searchForBytes(image.get(), size, tjad, 4, 1);
+  return searchForBytes(image, size, tjad, 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDF(const ByteBuffer& image, uInt32 size,
+bool CartDetector::isProbablyDF(const uInt8* image, uInt32 size,
                                 Bankswitch::Type& type)
 {
 
@@ -762,12 +799,12 @@ bool CartDetector::isProbablyDF(const ByteBuffer& image, uInt32 size,
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 df[]   = { 'D', 'F', 'D', 'F' };
   uInt8 dfsc[] = { 'D', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, df, 4, 1))
+  if(searchForBytes(image+size-8, 8, df, 4, 1))
   {
     type = Bankswitch::Type::_DF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, dfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, dfsc, 4, 1))
   {
     type = Bankswitch::Type::_DFSC;
     return true;
@@ -777,17 +814,17 @@ bool CartDetector::isProbablyDF(const ByteBuffer& image, uInt32 size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyDPCplus(const uInt8* image, uInt32 size)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
   uInt8 dpcp[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image.get(), size, dpcp, 4, 2);
+  return searchForBytes(image, size, dpcp, 4, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyE0(const uInt8* image, uInt32 size)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
@@ -806,14 +843,14 @@ bool CartDetector::isProbablyE0(const ByteBuffer& image, uInt32 size)
     { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
   };
   for(uInt32 i = 0; i < 8; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyE7(const uInt8* image, uInt32 size)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
@@ -831,14 +868,14 @@ bool CartDetector::isProbablyE7(const ByteBuffer& image, uInt32 size)
     { 0x8D, 0xE7, 0x1F }   // STA $1FE7
   };
   for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyE78K(const uInt8* image, uInt32 size)
 {
   // E78K cart bankswitching is triggered by accessing addresses
   // $FE4 to $FE6 using absolute non-indexed addressing
@@ -850,26 +887,26 @@ bool CartDetector::isProbablyE78K(const ByteBuffer& image, uInt32 size)
     { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
   };
   for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyEF(const ByteBuffer& image, uInt32 size,
+bool CartDetector::isProbablyEF(const uInt8* image, uInt32 size,
                                 Bankswitch::Type& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 efef[] = { 'E', 'F', 'E', 'F' };
   uInt8 efsc[] = { 'E', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, efef, 4, 1))
+  if(searchForBytes(image+size-8, 8, efef, 4, 1))
   {
     type = Bankswitch::Type::_EF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, efsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, efsc, 4, 1))
   {
     type = Bankswitch::Type::_EFSC;
     return true;
@@ -887,7 +924,7 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, uInt32 size,
   };
   for(uInt32 i = 0; i < 4; ++i)
   {
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
     {
       isEF = true;
       break;
@@ -906,7 +943,7 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, uInt32 size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFA2(const ByteBuffer& image, uInt32)
+bool CartDetector::isProbablyFA2(const uInt8* image, uInt32)
 {
   // This currently tests only the 32K version of FA2; the 24 and 28K
   // versions are easy, in that they're the only possibility with those
@@ -921,7 +958,7 @@ bool CartDetector::isProbablyFA2(const ByteBuffer& image, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyFE(const uInt8* image, uInt32 size)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
@@ -933,36 +970,36 @@ bool CartDetector::isProbablyFE(const ByteBuffer& image, uInt32 size)
     { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; STY $D6
   };
   for(uInt32 i = 0; i < 4; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 5, 1))
+    if(searchForBytes(image, size, signature[i], 5, 1))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyMDM(const uInt8* image, uInt32 size)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
   uInt8 mdmc[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image.get(), std::min(size, 8192u), mdmc, 4, 1);
+  return searchForBytes(image, std::min(size, 8192u), mdmc, 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablySB(const uInt8* image, uInt32 size)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
   uInt8 signature[2][3] = {
     { 0xBD, 0x00, 0x08 },  // LDA $0800,x
     { 0xAD, 0x00, 0x08 }   // LDA $0800
   };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
+  if(searchForBytes(image, size, signature[0], 3, 1))
     return true;
   else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+    return searchForBytes(image, size, signature[1], 3, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyUA(const uInt8* image, uInt32 size)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'
@@ -972,14 +1009,14 @@ bool CartDetector::isProbablyUA(const ByteBuffer& image, uInt32 size)
     { 0xBD, 0x1F, 0x02 }   // LDA $21F,X
   };
   for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const ByteBuffer& image, uInt32 size)
+bool CartDetector::isProbablyX07(const uInt8* image, uInt32 size)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
   uInt8 signature[6][3] = {
@@ -991,7 +1028,7 @@ bool CartDetector::isProbablyX07(const ByteBuffer& image, uInt32 size)
     { 0x0C, 0x2D, 0x08 }   // NOP $082D
   };
   for(uInt32 i = 0; i < 6; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(searchForBytes(image, size, signature[i], 3, 1))
       return true;
 
   return false;
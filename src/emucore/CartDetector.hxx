@@ -49,6 +49,30 @@ class CartDetector
                  const ByteBuffer& image, uInt32 size, string& md5,
                  const string& dtype, Settings& settings);
 
+    /**
+      Create a new cartridge object of the same type and with the same ROM
+      image as the given one, in its power-on state.  Unlike 'create', this
+      doesn't change any settings (the next part of a multicart isn't
+      selected), so it may be used while other threads read the settings.
+
+      @param cart     The cartridge to clone
+      @param md5      The md5sum of the cartridge's ROM image
+      @param settings The settings container
+      @return   Pointer to the new cartridge object allocated on the heap
+    */
+    static unique_ptr<Cartridge> clone(const Cartridge& cart,
+                 const string& md5, Settings& settings);
+
+    /**
+      Try to auto-detect the bankswitching type of the cartridge
+
+      @param image  A pointer to the ROM image
+      @param size   The size of the ROM image
+
+      @return The "best guess" for the cartridge type
+    */
+    static Bankswitch::Type autodetectType(const uInt8* image, uInt32 size);
+
   private:
     /**
       Create a cartridge from a multi-cart image pointer; internally this
@@ -69,6 +93,15 @@ class CartDetector
         uInt32 numroms, string& md5, Bankswitch::Type type, string& id,
         Settings& settings);
 
+    /**
+      Get the bankswitch type of one part of a multicart.
+
+      @param size  The size of the ROM image slice
+
+      @return  The bankswitch type of the slice
+    */
+    static Bankswitch::Type multiCartSliceType(uInt32 size);
+
     /**
       Create a cartridge from the entire image pointer.
 
@@ -84,16 +117,6 @@ class CartDetector
       createFromImage(const ByteBuffer& image, uInt32 size, Bankswitch::Type type,
                       const string& md5, Settings& settings);
 
-    /**
-      Try to auto-detect the bankswitching type of the cartridge
-
-      @param image  A pointer to the ROM image
-      @param size   The size of the ROM image
-
-      @return The "best guess" for the cartridge type
-    */
-    static Bankswitch::Type autodetectType(const ByteBuffer& image, uInt32 size);
-
     /**
       Search the image for the specified byte signature
 
@@ -113,142 +136,142 @@ class CartDetector
       Returns true if the image is probably a SuperChip (128 bytes RAM)
       Note: should be called only on ROMs with size multiple of 4K
     */
-    static bool isProbablySC(const ByteBuffer& image, uInt32 size);
+    static bool isProbablySC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyARM(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const ByteBuffer& image, uInt32 size);
+    static bool isProbably0840(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const ByteBuffer& image, uInt32 size);
+    static bool isProbably3E(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const ByteBuffer& image, uInt32 size);
+    static bool isProbably3EPlus(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const ByteBuffer& image, uInt32 size);
+    static bool isProbably3F(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
     */
-    static bool isProbably4A50(const ByteBuffer& image, uInt32 size);
+    static bool isProbably4A50(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 4K SuperChip (128 bytes RAM)
     */
-    static bool isProbably4KSC(const ByteBuffer& image, uInt32 size);
+    static bool isProbably4KSC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a BF/BFSC bankswitching cartridge
     */
-    static bool isProbablyBF(const ByteBuffer& image, uInt32 size, Bankswitch::Type& type);
+    static bool isProbablyBF(const uInt8* image, uInt32 size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyBUS(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyCDF(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyCTY(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyCV(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CV+ bankswitching cartridge
     */
-    static bool isProbablyCVPlus(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyCVPlus(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a DASH bankswitching cartridge
     */
-    static bool isProbablyDASH(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyDASH(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
     */
-    static bool isProbablyDF(const ByteBuffer& image, uInt32 size, Bankswitch::Type& type);
+    static bool isProbablyDF(const uInt8* image, uInt32 size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyDPCplus(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyE0(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyE7(const uInt8* image, uInt32 size);
 
     /**
     Returns true if the image is probably a E78K bankswitching cartridge
     */
-    static bool isProbablyE78K(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyE78K(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const ByteBuffer& image, uInt32 size, Bankswitch::Type& type);
+    static bool isProbablyEF(const uInt8* image, uInt32 size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
     */
-    //static bool isProbablyF6(const ByteBuffer& image, uInt32 size);
+    //static bool isProbablyF6(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an FA2 bankswitching cartridge
     */
-    static bool isProbablyFA2(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyFA2(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyFE(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyMDM(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const ByteBuffer& image, uInt32 size);
+    static bool isProbablySB(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyUA(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const ByteBuffer& image, uInt32 size);
+    static bool isProbablyX07(const uInt8* image, uInt32 size);
 
   private:
     // Following constructors and assignment operators not supported
@@ -54,6 +54,9 @@ void CartridgeE0::install(System& system)
 {
   mySystem = &system;
 
+  // Build the page accessing methods of all slices of the first three segments
+  myBankPages.create(*this, myImage, myCodeAccessBase.get(), 8);
+
   System::PageAccess access(this, System::PageAccessType::READ);
 
   // Set the page acessing methods for the first part of the last segment
@@ -124,17 +127,9 @@ void CartridgeE0::segmentZero(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[0] = slice;
-  uInt16 offset = slice << 10;
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
 
-  for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the pages of the slice
+  myBankPages.map(*mySystem, 0x1000, slice);
   myBankChanged = true;
 }
 
@@ -145,17 +140,9 @@ void CartridgeE0::segmentOne(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[1] = slice;
-  uInt16 offset = slice << 10;
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
 
-  for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the pages of the slice
+  myBankPages.map(*mySystem, 0x1400, slice);
   myBankChanged = true;
 }
 
@@ -166,17 +153,9 @@ void CartridgeE0::segmentTwo(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[2] = slice;
-  uInt16 offset = slice << 10;
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PageAccessType::READ);
 
-  for(uInt16 addr = 0x1800; addr < 0x1C00; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the pages of the slice
+  myBankPages.map(*mySystem, 0x1800, slice);
   myBankChanged = true;
 }
 
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "BankPages.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartE0Widget.hxx"
 #endif
@@ -170,6 +171,9 @@ class CartridgeE0 : public Cartridge
     // The 8K ROM image of the cartridge
     uInt8 myImage[8192];
 
+    // The page accessing methods of all slices
+    BankPages<1024> myBankPages;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeE0() = delete;
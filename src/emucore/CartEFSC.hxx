@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "BankPages.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartEFSCWidget.hxx"
 #endif
@@ -161,6 +162,9 @@ class CartridgeEFSC : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
+    // The page accessing methods of all banks
+    BankPages<4096> myBankPages;
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeEFSC() = delete;
@@ -57,6 +57,8 @@
 #include "TIAConstants.hxx"
 #include "FrameLayout.hxx"
 #include "AudioQueue.hxx"
+#include "DetectionCache.hxx"
+#include "DisplayDetector.hxx"
 #include "AudioSettings.hxx"
 #include "frame-manager/FrameManager.hxx"
 #include "frame-manager/FrameLayoutDetector.hxx"
@@ -138,9 +140,55 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   myOSystem.sound().mute(1);
   myOSystem.frameBuffer().clear();
 
-  if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
+  // Reuse the results of earlier autodetections of this ROM if possible
+  DetectionCache& cache = myOSystem.detectionCache();
+  const bool useCache = myOSystem.settings().getBool("detectcache");
+  const string cacheKey = detectionCacheKey();
+  string cached;
+
+  const bool detectLayout =
+      myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo");
+  const bool detectYStart =
+      atoi(myProperties.get(PropType::Display_YStart).c_str()) == 0;
+  const bool layoutCached = detectLayout && useCache &&
+      cache.get(cacheKey + "|layout", cached) &&
+      (cached == "NTSC" || cached == "PAL");
+
+  // If both the frame layout and YStart must be detected, do so concurrently
+  // on copies of the system where possible
+  // The copies get the same controllers as the console; this isn't possible
+  // for the CompuMate and for controllers accessing files or serial ports,
+  // so these are always detected on the console itself
+  const auto duplicable = [](const string& type) {
+    return type != "" && type != "ATARIVOX" && type != "SAVEKEY" &&
+           type != "KIDVID";
+  };
+  const Controller::Jack leftJack = myLeftControl->jack(),
+                         rightJack = myRightControl->jack();
+  DisplayDetector detector(*myCart, myProperties, myOSystem.settings(),
+      [this, &md5, leftJack, rightJack]
+      (Controller::Jack port, const Event& event, const System& system) {
+        return port == Controller::Jack::Left
+          ? createController(md5, myLeftControlType, leftJack, event, system)
+          : createController(md5, myRightControlType, rightJack, event, system);
+      });
+  const bool detectedConcurrently = detectLayout && !layoutCached &&
+      detectYStart && duplicable(myLeftControlType) &&
+      duplicable(myRightControlType) && DisplayDetector::available() &&
+      detector.run();
+
+  if(detectLayout)
   {
-    autodetectFrameLayout();
+    if(layoutCached)
+      myDisplayFormat = cached;
+    else
+    {
+      if(detectedConcurrently)
+        myDisplayFormat = detector.detectedLayout() == FrameLayout::pal ? "PAL" : "NTSC";
+      else
+        autodetectFrameLayout();
+      cache.set(cacheKey + "|layout", myDisplayFormat);
+    }
 
     if(myProperties.get(PropType::Display_Format) == "AUTO")
     {
@@ -150,8 +198,22 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
     }
   }
 
-  if (atoi(myProperties.get(PropType::Display_YStart).c_str()) == 0) {
-    autodetectYStart();
+  if (detectYStart) {
+    // YStart is detected using the current display format
+    const string ystartKey = cacheKey + "|ystart." + myDisplayFormat;
+
+    if (useCache && cache.get(ystartKey, cached) && !cached.empty() &&
+        std::all_of(cached.begin(), cached.end(), ::isdigit) &&
+        uInt32(atoi(cached.c_str())) <= TIAConstants::maxYStart)
+      myAutodetectedYstart = atoi(cached.c_str());
+    else {
+      if (detectedConcurrently)
+        myAutodetectedYstart = detector.detectedYStart(
+          myDisplayFormat == "PAL" ? FrameLayout::pal : FrameLayout::ntsc) - YSTART_EXTRA;
+      else
+        autodetectYStart();
+      cache.set(ystartKey, std::to_string(myAutodetectedYstart));
+    }
   }
 
   myConsoleInfo.DisplayFormat = myDisplayFormat + autodetected;
@@ -251,6 +313,38 @@ void Console::autodetectFrameLayout(bool reset)
   myOSystem.settings().setValue("fastscbios", fastscbios);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Console::detectionCacheKey() const
+{
+  // The detection runs the ROM from power-on, so everything that changes
+  // the initial state, the console switches or the controllers is part of
+  // the key
+  const Settings& settings = myOSystem.settings();
+  const string prefix = settings.getBool("dev.settings") ? "dev." : "plr.";
+
+  ostringstream key;
+  key << myProperties.get(PropType::Cart_MD5)
+      << "|" << myProperties.get(PropType::Cart_Type)
+      << "|" << myProperties.get(PropType::Cart_StartBank)
+      << "|" << myProperties.get(PropType::Console_LeftDiff)
+      << "|" << myProperties.get(PropType::Console_RightDiff)
+      << "|" << myProperties.get(PropType::Console_TVType)
+      << "|" << myProperties.get(PropType::Console_SwapPorts)
+      << "|" << myProperties.get(PropType::Controller_Left)
+      << "|" << myProperties.get(PropType::Controller_Right)
+      << "|" << myProperties.get(PropType::Controller_SwapPaddles)
+      << "|" << settings.getString(prefix + "console")
+      << "|" << settings.getBool(prefix + "bankrandom")
+      << "|" << settings.getBool(prefix + "ramrandom")
+      << "|" << settings.getString(prefix + "cpurandom");
+
+  // Keys must not contain whitespace
+  string result = key.str();
+  std::replace_if(result.begin(), result.end(), ::isspace, '_');
+
+  return result;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::redetectFrameLayout()
 {
@@ -801,6 +895,7 @@ void Console::setControllers(const string& rommd5)
 
     myLeftControl  = std::move(myCMHandler->leftController());
     myRightControl = std::move(myCMHandler->rightController());
+    myLeftControlType = myRightControlType = "";
   }
   else
   {
@@ -828,11 +923,15 @@ void Console::setControllers(const string& rommd5)
     {
       myLeftControl = std::move(leftC);
       myRightControl = std::move(rightC);
+      myLeftControlType = left;
+      myRightControlType = right;
     }
     else
     {
       myLeftControl = std::move(rightC);
       myRightControl = std::move(leftC);
+      myLeftControlType = right;
+      myRightControlType = left;
     }
   }
 
@@ -847,24 +946,36 @@ unique_ptr<Controller> Console::getControllerPort(const string& rommd5,
 
   myOSystem.eventHandler().enableKeyControllerEvents(controllerName, port);
 
+  // Joysticks are already created in c'tor
+  // We save some time by not looking at all the other types
+  if(controllerName == "JOYSTICK" && controller)
+    return controller;
+
+  return createController(rommd5, controllerName, port, myEvent, *mySystem);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<Controller> Console::createController(const string& rommd5,
+    const string& controllerName, Controller::Jack port,
+    const Event& event, const System& system)
+{
+  unique_ptr<Controller> controller;
+
   if(controllerName == "JOYSTICK")
   {
-    // Already created in c'tor
-    // We save some time by not looking at all the other types
-    if(!controller)
-      controller = make_unique<Joystick>(port, myEvent, *mySystem);
+    controller = make_unique<Joystick>(port, event, system);
   }
   else if(controllerName == "BOOSTERGRIP")
   {
-    controller = make_unique<BoosterGrip>(port, myEvent, *mySystem);
+    controller = make_unique<BoosterGrip>(port, event, system);
   }
   else if(controllerName == "DRIVING")
   {
-    controller = make_unique<Driving>(port, myEvent, *mySystem);
+    controller = make_unique<Driving>(port, event, system);
   }
   else if((controllerName == "KEYBOARD") || (controllerName == "KEYPAD"))
   {
-    controller = make_unique<Keyboard>(port, myEvent, *mySystem);
+    controller = make_unique<Keyboard>(port, event, system);
   }
   else if(BSPF::startsWithIgnoreCase(controllerName, "PADDLES"))
   {
@@ -875,20 +986,20 @@ unique_ptr<Controller> Console::getControllerPort(const string& rommd5,
       swapAxis = true;
     else if(controllerName == "PADDLES_IAXDR")
       swapAxis = swapDir = true;
-    controller = make_unique<Paddles>(port, myEvent, *mySystem,
+    controller = make_unique<Paddles>(port, event, system,
                                       swapPaddles, swapAxis, swapDir);
   }
   else if(controllerName == "AMIGAMOUSE")
   {
-    controller = make_unique<AmigaMouse>(port, myEvent, *mySystem);
+    controller = make_unique<AmigaMouse>(port, event, system);
   }
   else if(controllerName == "ATARIMOUSE")
   {
-    controller = make_unique<AtariMouse>(port, myEvent, *mySystem);
+    controller = make_unique<AtariMouse>(port, event, system);
   }
   else if(controllerName == "TRAKBALL")
   {
-    controller = make_unique<TrakBall>(port, myEvent, *mySystem);
+    controller = make_unique<TrakBall>(port, event, system);
   }
   else if(controllerName == "ATARIVOX")
   {
@@ -898,7 +1009,7 @@ unique_ptr<Controller> Console::getControllerPort(const string& rommd5,
       if(os.settings().getBool(devSettings ? "dev.eepromaccess" : "plr.eepromaccess"))
         os.frameBuffer().showMessage(msg);
     };
-    controller = make_unique<AtariVox>(port, myEvent, *mySystem,
+    controller = make_unique<AtariVox>(port, event, system,
         myOSystem.settings().getString("avoxport"), nvramfile, callback);
   }
   else if(controllerName == "SAVEKEY")
@@ -909,22 +1020,22 @@ unique_ptr<Controller> Console::getControllerPort(const string& rommd5,
       if(os.settings().getBool(devSettings ? "dev.eepromaccess" : "plr.eepromaccess"))
         os.frameBuffer().showMessage(msg);
     };
-    controller = make_unique<SaveKey>(port, myEvent, *mySystem, nvramfile, callback);
+    controller = make_unique<SaveKey>(port, event, system, nvramfile, callback);
   }
   else if(controllerName == "GENESIS")
   {
-    controller = make_unique<Genesis>(port, myEvent, *mySystem);
+    controller = make_unique<Genesis>(port, event, system);
   }
   else if(controllerName == "KIDVID")
   {
-    controller = make_unique<KidVid>(port, myEvent, *mySystem, rommd5);
+    controller = make_unique<KidVid>(port, event, system, rommd5);
   }
   else if(controllerName == "MINDLINK")
   {
-    controller = make_unique<MindLink>(port, myEvent, *mySystem);
+    controller = make_unique<MindLink>(port, event, system);
   }
   else  // What else can we do?
-    controller = make_unique<Joystick>(port, myEvent, *mySystem);
+    controller = make_unique<Joystick>(port, event, system);
 
   return controller;
 }
@@ -309,6 +309,12 @@ class Console : public Serializable, public ConsoleIO
      */
     void autodetectYStart(bool reset = true);
 
+    /**
+     * The key of this console in the detection cache; it consists of the
+     * MD5 and all properties and settings that influence the detection.
+     */
+    string detectionCacheKey() const;
+
     /**
      * Rerun frame layout autodetection
      */
@@ -341,6 +347,14 @@ class Console : public Serializable, public ConsoleIO
     unique_ptr<Controller> getControllerPort(const string& rommd5,
         const string& controllerName, Controller::Jack port);
 
+    /**
+      Creates a controller of the given type, plugged into the given port
+      of the given system.
+    */
+    unique_ptr<Controller> createController(const string& rommd5,
+        const string& controllerName, Controller::Jack port,
+        const Event& event, const System& system);
+
     /**
       Loads a user-defined palette file (from OSystem::paletteFile), filling the
       appropriate user-defined palette arrays.
@@ -395,6 +409,10 @@ class Console : public Serializable, public ConsoleIO
     // Pointers to the left and right controllers
     unique_ptr<Controller> myLeftControl, myRightControl;
 
+    // The types of the left and right controllers, as detected when they
+    // were added (empty for the CompuMate)
+    string myLeftControlType, myRightControlType;
+
     // Pointer to CompuMate handler (only used in CompuMate ROMs)
     shared_ptr<CompuMate> myCMHandler;
 
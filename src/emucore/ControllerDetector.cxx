@@ -24,12 +24,28 @@
 string ControllerDetector::detectType(const uInt8* image, uInt32 size,
                                       const string& controller, const Controller::Jack port,
                                       const Settings& settings)
+{
+  return detectType(image, size, controller, port, settings.getBool("rominfo"));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ControllerDetector::detectName(const uInt8* image, uInt32 size,
+                                      const string& controller, const Controller::Jack port,
+                                      const Settings& settings)
+{
+  return getControllerName(detectType(image, size, controller, port, settings));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ControllerDetector::detectType(const uInt8* image, uInt32 size,
+                                      const string& controller, const Controller::Jack port,
+                                      bool force)
 {
   string type(controller);
 
-  if(type == "AUTO" || settings.getBool("rominfo"))
+  if(type == "AUTO" || force)
   {
-    string detectedType = autodetectPort(image, size, port, settings);
+    string detectedType = autodetectPort(image, size, port);
 
     if(type != "AUTO" && type != detectedType)
     {
@@ -45,14 +61,14 @@ string ControllerDetector::detectType(const uInt8* image, uInt32 size,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string ControllerDetector::detectName(const uInt8* image, uInt32 size,
                                       const string& controller, const Controller::Jack port,
-                                      const Settings& settings)
+                                      bool force)
 {
-  return getControllerName(detectType(image, size, controller, port, settings));
+  return getControllerName(detectType(image, size, controller, port, force));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string ControllerDetector::autodetectPort(const uInt8* image, uInt32 size,
-                                          Controller::Jack port, const Settings& settings)
+                                          Controller::Jack port)
 {
   // default type joystick
   string type = "JOYSTICK"; // TODO: remove magic strings
@@ -74,7 +90,7 @@ string ControllerDetector::autodetectPort(const uInt8* image, uInt32 size,
   }
   else
   {
-    if(usesPaddle(image, size, port, settings))
+    if(usesPaddle(image, size, port))
       type = "PADDLES";
   }
   // TODO: BOOSTERGRIP, DRIVING, MINDLINK, ATARIVOX, KIDVID
@@ -425,7 +441,7 @@ bool ControllerDetector::usesGenesisButton(const uInt8* image, uInt32 size, Cont
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ControllerDetector::usesPaddle(const uInt8* image, uInt32 size,
-                                    Controller::Jack port, const Settings& settings)
+                                    Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
   {
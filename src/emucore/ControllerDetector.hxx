@@ -60,6 +60,26 @@ class ControllerDetector
                              const string& controller, const Controller::Jack port,
                              const Settings& settings);
 
+    /**
+      Like the above, but independent of the settings, so that it may be
+      used from any thread.
+
+      @param image      A pointer to the ROM image
+      @param size       The size of the ROM image
+      @param controller The provided controller type of the ROM image
+      @param port       The port to be checked
+      @param force      Detect the type even if a controller is provided
+                        (the value of the 'rominfo' setting)
+
+      @return   The (detected) controller type or name
+    */
+    static string detectType(const uInt8* image, uInt32 size,
+                             const string& controller, const Controller::Jack port,
+                             bool force);
+    static string detectName(const uInt8* image, uInt32 size,
+                             const string& controller, const Controller::Jack port,
+                             bool force);
+
     /**
       Returns a nicer formatted name for the given controller.
 
@@ -76,12 +96,10 @@ class ControllerDetector
       @param image      A pointer to the ROM image
       @param size       The size of the ROM image
       @param port       The port to be checked
-      @param settings   A reference to the various settings (read-only)
 
       @return   The detected controller type
     */
-    static string autodetectPort(const uInt8* image, uInt32 size, Controller::Jack port,
-                                 const Settings& settings);
+    static string autodetectPort(const uInt8* image, uInt32 size, Controller::Jack port);
 
     /**
       Search the image for the specified byte signature.
@@ -106,8 +124,7 @@ class ControllerDetector
     static bool usesGenesisButton(const uInt8* image, uInt32 size, Controller::Jack port);
 
     // Returns true if the port's paddle button access code is found.
-    static bool usesPaddle(const uInt8* image, uInt32 size, Controller::Jack port,
-                           const Settings& settings);
+    static bool usesPaddle(const uInt8* image, uInt32 size, Controller::Jack port);
 
     // Returns true if a Trak-Ball table is found.
     static bool isProbablyTrakBall(const uInt8* image, uInt32 size);
@@ -0,0 +1,113 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+
+#include "DetectionCache.hxx"
+
+constexpr char DetectionCache::VERSION[];
+constexpr size_t DetectionCache::MAX_ENTRIES;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::load(const string& filename)
+{
+  ifstream in(filename);
+
+  string version;
+  if(!(in >> version) || version != VERSION)
+    return;
+
+  // The entries are stored from the least to the most recently used
+  string key, value;
+  while(in >> key >> value)
+    set(key, value);
+
+  myChanged = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::save(const string& filename) const
+{
+  if(!myChanged)
+    return false;
+
+  ofstream out(filename);
+  if(!out)
+    return false;
+
+  using KeyEntry = std::map<string, Entry>::value_type;
+  vector<const KeyEntry*> entries;
+  entries.reserve(myEntries.size());
+  for(const auto& entry: myEntries)
+    entries.push_back(&entry);
+  std::sort(entries.begin(), entries.end(),
+    [](const KeyEntry* a, const KeyEntry* b) {
+      return a->second.lastUse < b->second.lastUse;
+    });
+
+  out << VERSION << endl;
+  for(const KeyEntry* entry: entries)
+    out << entry->first << " " << entry->second.value << endl;
+
+  myChanged = false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::get(const string& key, string& value)
+{
+  const auto entry = myEntries.find(key);
+  if(entry == myEntries.end())
+    return false;
+
+  value = entry->second.value;
+  touch(entry->second);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::set(const string& key, const string& value)
+{
+  // Make room for a new entry by dropping the least recently used one
+  if(myEntries.size() >= MAX_ENTRIES && myEntries.find(key) == myEntries.end())
+    myEntries.erase(std::min_element(myEntries.begin(), myEntries.end(),
+      [](const std::map<string, Entry>::value_type& a,
+         const std::map<string, Entry>::value_type& b) {
+        return a.second.lastUse < b.second.lastUse;
+      }));
+
+  Entry& entry = myEntries[key];
+  if(entry.value != value)
+  {
+    entry.value = value;
+    myChanged = true;
+  }
+  touch(entry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::touch(Entry& entry)
+{
+  // Using the most recently used entry again doesn't change the order
+  if(entry.lastUse == 0 || entry.lastUse != myUses)
+  {
+    entry.lastUse = ++myUses;
+    myChanged = true;
+  }
+}
@@ -0,0 +1,109 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DETECTION_CACHE_HXX
+#define DETECTION_CACHE_HXX
+
+#include <map>
+
+#include "bspf.hxx"
+
+/**
+  This class remembers the results of the (time consuming) frame layout and
+  YStart autodetection, which emulate the ROM for a number of frames each
+  time a console is created.  The results are stored by a key which
+  identifies the ROM (by MD5) and everything else that may influence the
+  detection; see Console::detectionCacheKey().
+
+  The cache is loaded from and saved to a file (stella.det), one entry per
+  line, from the least to the most recently used.  Files written by a
+  different version of the cache are ignored.  Once the cache holds
+  MAX_ENTRIES entries, each new entry replaces the least recently used one.
+*/
+class DetectionCache
+{
+  public:
+    DetectionCache() = default;
+
+    /**
+      Load the cache from the specified file.
+
+      @param filename  Full pathname of input file to use
+    */
+    void load(const string& filename);
+
+    /**
+      Save the cache to the specified file, if it has changed.
+
+      @param filename  Full pathname of output file to use
+
+      @return  True on success, false on failure or save not needed
+    */
+    bool save(const string& filename) const;
+
+    /**
+      Get a cached detection result, and mark it as most recently used.
+
+      @param key    The key of the result
+      @param value  The cached result, if found
+
+      @return  True if a result was found, else false
+    */
+    bool get(const string& key, string& value);
+
+    /**
+      Store a detection result (keys and values must not contain whitespace).
+
+      @param key    The key of the result
+      @param value  The result
+    */
+    void set(const string& key, const string& value);
+
+  private:
+    struct Entry {
+      string value;
+      uInt64 lastUse{0};  // the value of myUses when the entry was last used
+    };
+
+    // Marks the entry as most recently used
+    void touch(Entry& entry);
+
+  private:
+    std::map<string, Entry> myEntries;
+
+    // The number of uses of all entries so far
+    uInt64 myUses{0};
+
+    // Indicates that entries were added or used since the cache was loaded
+    mutable bool myChanged{false};
+
+    // The maximum number of entries kept (there are up to two per ROM)
+    static constexpr size_t MAX_ENTRIES = 4000;
+
+    // Identifies the file format and the detection algorithms; increment
+    // this whenever the detection changes to invalidate existing caches
+    static constexpr char VERSION[] = "StellaDetectionCache2";
+
+  private:
+    // Following constructors and assignment operators not supported
+    DetectionCache(const DetectionCache&) = delete;
+    DetectionCache(DetectionCache&&) = delete;
+    DetectionCache& operator=(const DetectionCache&) = delete;
+    DetectionCache& operator=(DetectionCache&&) = delete;
+};
+
+#endif
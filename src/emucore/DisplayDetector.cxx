@@ -0,0 +1,184 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <thread>
+
+#include "Cart.hxx"
+#include "CartDetector.hxx"
+#include "ConsoleIO.hxx"
+#include "ConsoleTiming.hxx"
+#include "Event.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "Props.hxx"
+#include "Random.hxx"
+#include "Settings.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "TimerManager.hxx"
+#include "frame-manager/FrameLayoutDetector.hxx"
+#include "frame-manager/YStartDetector.hxx"
+
+#include "DisplayDetector.hxx"
+
+namespace {
+  // The number of frames each detector is run for
+  constexpr uInt32 FRAME_LAYOUT_FRAMES = 60;
+  constexpr uInt32 YSTART_FRAMES = 80;
+
+  struct IO: public ConsoleIO {
+    Controller& leftController() const override { return *myLeftControl; }
+    Controller& rightController() const override { return *myRightControl; }
+    Switches& switches() const override { return *mySwitches; }
+
+    unique_ptr<Controller> myLeftControl;
+    unique_ptr<Controller> myRightControl;
+    unique_ptr<Switches> mySwitches;
+  };
+
+  // Run a detector on a throw-away system for the given number of frames;
+  // the system has the same controllers as the console while detecting
+  void runDetector(Cartridge& cart, const Properties& props, Settings& settings,
+                   const DisplayDetector::ControllerFactory& controllers,
+                   AbstractFrameManager& frameManager, uInt32 frames)
+  {
+    IO consoleIO;
+    Random rng(static_cast<uInt32>(TimerManager::getTicks()));
+    Event event;
+
+    M6502 cpu(settings);
+    M6532 riot(consoleIO, settings);
+    TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, settings);
+    System system(rng, cpu, riot, tia, cart);
+
+    consoleIO.myLeftControl =
+        controllers(Controller::Jack::Left, event, system);
+    consoleIO.myRightControl =
+        controllers(Controller::Jack::Right, event, system);
+    consoleIO.mySwitches = make_unique<Switches>(event, props, settings);
+
+    tia.bindToControllers();
+    cart.setStartBankFromPropsFunc([&props]() {
+      const string& startbank = props.get(PropType::Cart_StartBank);
+      return startbank == EmptyString ? -1 : atoi(startbank.c_str());
+    });
+    system.initialize();
+
+    tia.setFrameManager(&frameManager);
+    system.reset(true);
+
+    for(uInt32 i = 0; i < frames; ++i) tia.update();
+
+    tia.clearFrameManager();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DisplayDetector::DisplayDetector(const Cartridge& cart, const Properties& props,
+                                 Settings& settings,
+                                 const ControllerFactory& controllers)
+  : myCart(cart),
+    myProperties(props),
+    mySettings(settings),
+    myControllers(controllers),
+    myLayout(FrameLayout::ntsc),
+    myYStartNTSC(0),
+    myYStartPAL(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DisplayDetector::available()
+{
+  return std::thread::hardware_concurrency() > 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DisplayDetector::run()
+{
+  const string& md5 = myProperties.get(PropType::Cart_MD5);
+  unique_ptr<Cartridge> layoutCart, ntscCart, palCart;
+
+  // Creating the cartridges may change the settings, so it must be done
+  // before the threads are started
+  try
+  {
+    layoutCart = CartDetector::clone(myCart, md5, mySettings);
+    ntscCart   = CartDetector::clone(myCart, md5, mySettings);
+    palCart    = CartDetector::clone(myCart, md5, mySettings);
+  }
+  catch(const std::exception&)
+  {
+    return false;
+  }
+  if(!layoutCart || !ntscCart || !palCart)
+    return false;
+
+  // We turn off the SuperCharger progress bars, otherwise the SC BIOS
+  // will take over 250 frames!
+  // The 'fastscbios' option must be changed before the threads are started,
+  // and must not be changed again until they are finished
+  bool fastscbios = mySettings.getBool("fastscbios");
+  mySettings.setValue("fastscbios", true);
+
+  FrameLayoutDetector frameLayoutDetector;
+  YStartDetector ystartDetectorNTSC, ystartDetectorPAL;
+  ystartDetectorNTSC.setLayout(FrameLayout::ntsc);
+  ystartDetectorPAL.setLayout(FrameLayout::pal);
+
+  // Errors (ie, from the ARM emulation) can't leave a thread, so they are
+  // caught and reported by failing; the caller then runs the detection on
+  // the console itself, and gets the error there
+  auto detect = [this](Cartridge& cart, AbstractFrameManager& frameManager,
+                       uInt32 frames, bool& ok) {
+    try
+    {
+      runDetector(cart, myProperties, mySettings, myControllers,
+                  frameManager, frames);
+      ok = true;
+    }
+    catch(const std::exception&)
+    {
+      ok = false;
+    }
+  };
+
+  bool ntscOk = false, palOk = false, layoutOk = false;
+  std::thread ntscThread(detect, std::ref(*ntscCart),
+      std::ref(ystartDetectorNTSC), YSTART_FRAMES, std::ref(ntscOk));
+  std::thread palThread(detect, std::ref(*palCart),
+      std::ref(ystartDetectorPAL), YSTART_FRAMES, std::ref(palOk));
+
+  // The frame layout detection is the shortest, so it runs on this thread
+  detect(*layoutCart, frameLayoutDetector, FRAME_LAYOUT_FRAMES, layoutOk);
+
+  ntscThread.join();
+  palThread.join();
+
+  // Don't forget to reset the SC progress bars again
+  mySettings.setValue("fastscbios", fastscbios);
+
+  if(!ntscOk || !palOk || !layoutOk)
+    return false;
+
+  myLayout = frameLayoutDetector.detectedLayout();
+  myYStartNTSC = ystartDetectorNTSC.detectedYStart();
+  myYStartPAL = ystartDetectorPAL.detectedYStart();
+
+  return true;
+}
@@ -0,0 +1,109 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DISPLAY_DETECTOR_HXX
+#define DISPLAY_DETECTOR_HXX
+
+class Cartridge;
+class Event;
+class Properties;
+class Settings;
+class System;
+
+#include <functional>
+
+#include "bspf.hxx"
+#include "Control.hxx"
+#include "FrameLayout.hxx"
+
+/**
+  Runs the frame layout and YStart autodetection of a ROM concurrently.
+
+  Normally, the YStart is detected after the frame layout, since it depends
+  on it, and both run on the console itself.  Here, each detector runs on
+  its own thread, with a throw-away system, a clone of the cartridge in
+  its power-on state, and the same controllers as the console.  The
+  YStart is detected for both NTSC and PAL, and the caller picks the one
+  matching the detected layout.  Thus the time needed is that of the
+  slowest detector, instead of the sum of both.
+
+  Since the detectors start from power-on, the results are the same as
+  those of running them one after another on the console.
+*/
+class DisplayDetector
+{
+  public:
+    /**
+      Creates the controller for the left or right port of a throw-away
+      system; it is called from the detector threads.
+    */
+    using ControllerFactory = std::function<unique_ptr<Controller>(
+        Controller::Jack port, const Event& event, const System& system)>;
+
+    /**
+      Create a new detector for the given cartridge.
+
+      @param cart         The cartridge to clone for the detection
+      @param props        The properties of the cartridge
+      @param settings     The settings container (only read while running)
+      @param controllers  Creates the same controllers as the console's
+    */
+    DisplayDetector(const Cartridge& cart, const Properties& props,
+                    Settings& settings, const ControllerFactory& controllers);
+
+    /**
+      Answer whether running the detectors concurrently is worth it; this
+      is not the case on a single core, where they would only slow each
+      other down.
+    */
+    static bool available();
+
+    /**
+      Run the frame layout and YStart detection.
+
+      @return  False if the cartridge couldn't be cloned or emulated
+    */
+    bool run();
+
+    /**
+      Query the detection results; only valid after 'run' was successful.
+    */
+    FrameLayout detectedLayout() const { return myLayout; }
+    uInt32 detectedYStart(FrameLayout layout) const {
+      return layout == FrameLayout::pal ? myYStartPAL : myYStartNTSC;
+    }
+
+  private:
+    const Cartridge& myCart;
+    const Properties& myProperties;
+    Settings& mySettings;
+    ControllerFactory myControllers;
+
+    FrameLayout myLayout;
+    uInt32 myYStartNTSC;
+    uInt32 myYStartPAL;
+
+  private:
+    // Following constructors and assignment operators not supported
+    DisplayDetector() = delete;
+    DisplayDetector(const DisplayDetector&) = delete;
+    DisplayDetector(DisplayDetector&&) = delete;
+    DisplayDetector& operator=(const DisplayDetector&) = delete;
+    DisplayDetector& operator=(DisplayDetector&&) = delete;
+};
+
+#endif
@@ -172,7 +172,7 @@ uInt32 FilesystemNode::read(ByteBuffer& image) const
     return size;
 
   // Otherwise, the default behaviour is to read from a normal C++ ifstream
-  image = make_unique<uInt8[]>(512 * 1024);
+  image = make_unique<uInt8[]>(MAX_READ_SIZE);
   ifstream in(getPath(), std::ios::binary);
   if(in)
   {
@@ -183,7 +183,7 @@ uInt32 FilesystemNode::read(ByteBuffer& image) const
     if(length == 0)
       throw runtime_error("Zero-byte file");
 
-    size = std::min(uInt32(length), 512u * 1024u);
+    size = std::min(uInt32(length), uInt32(MAX_READ_SIZE));
     in.read(reinterpret_cast<char*>(image.get()), size);
   }
   else
@@ -191,3 +191,30 @@ uInt32 FilesystemNode::read(ByteBuffer& image) const
 
   return size;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNode::map(MappedData& data, uInt32 maxSize) const
+{
+  // File must actually exist
+  if(!(exists() && isReadable()))
+    throw runtime_error("File not found/readable");
+
+  // First let the private subclass attempt to map the file
+  uInt32 size = _realNode->map(data, maxSize);
+  if(size > 0)
+    return size;
+
+  // Otherwise, the data is read into a buffer
+  ByteBuffer image;
+  size = read(image);
+  data = MappedData(image.release(), [](const uInt8* p) { delete[] p; });
+
+  return std::min(size, maxSize);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getFileInfo(uInt64& size, uInt64& modified) const
+{
+  return _realNode && _realNode->isFile() &&
+         _realNode->getFileInfo(size, modified);
+}
@@ -51,6 +51,12 @@ class FilesystemNode;
 class AbstractFSNode;
 using AbstractFSNodePtr = shared_ptr<AbstractFSNode>;
 
+/**
+ * Read-only data of a file, as returned by FilesystemNode::map().  Its
+ * deleter releases the memory mapping (or buffer) the data lives in.
+ */
+using MappedData = shared_ptr<const uInt8>;
+
 /**
  * List of multiple file system nodes. E.g. the contents of a given directory.
  * This is subclass instead of just a typedef so that we can use forward
@@ -65,6 +71,11 @@ class FSList : public vector<FilesystemNode> { };
 class FilesystemNode
 {
   public:
+    /**
+     * The maximum number of bytes read from a file.
+     */
+    static constexpr uInt32 MAX_READ_SIZE = 512 * 1024;
+
     /**
      * Flag to tell listDir() which kind of files to list.
      */
@@ -245,6 +256,37 @@ class FilesystemNode
      */
     uInt32 read(ByteBuffer& buffer) const;
 
+    /**
+     * Get read-only access to the data of the file.  The file is memory-mapped
+     * if the backend supports it and the file can't be modified meanwhile
+     * (i.e. it is read-only), and read into a buffer otherwise.  This
+     * avoids copying data which is only inspected (e.g. to calculate its MD5
+     * or to detect the cartridge type); code which needs to modify the data
+     * must make its own copy.  Since a mapping may keep the file locked, the
+     * data should be released as soon as it is no longer needed.
+     *
+     * @param data     Receives the data; it stays valid as long as (a copy
+     *                 of) the pointer exists
+     * @param maxSize  The maximum number of bytes to make available
+     *
+     * @return  The number of bytes available (0 in the case of failure)
+     *          This method can throw exceptions, and should be used inside
+     *          a try-catch block.
+     */
+    uInt32 map(MappedData& data, uInt32 maxSize = MAX_READ_SIZE) const;
+
+    /**
+     * Get the size and the time of the last modification of the file.
+     * The time is in a backend-specific unit, and is only useful to check
+     * whether a file has changed since it was last looked at.
+     *
+     * @param size      The size of the file
+     * @param modified  The time of the last modification
+     *
+     * @return  true if the info is available, false otherwise
+     */
+    bool getFileInfo(uInt64& size, uInt64& modified) const;
+
     /**
      * The following methods are almost exactly the same as the various
      * getXXXX() methods above.  Internally, they call the respective methods
@@ -393,6 +435,25 @@ class AbstractFSNode
      */
     virtual uInt32 read(ByteBuffer& buffer) const { return 0; }
 
+    /**
+     * Memory-map the file (read-only), if it can't be modified meanwhile.
+     *
+     * @param data     Receives the mapped data
+     * @param maxSize  The maximum number of bytes to map
+     *
+     * @return  The number of bytes mapped (0 if the backend doesn't support
+     *          mapping, the file may change, or mapping failed)
+     */
+    virtual uInt32 map(MappedData& data, uInt32 maxSize) const { return 0; }
+
+    /**
+     * Get the size and the time of the last modification of the file.
+     *
+     * @return  true if the info is available, false otherwise (the default
+     *          for backends which don't support it)
+     */
+    virtual bool getFileInfo(uInt64& size, uInt64& modified) const { return false; }
+
     /**
      * The parent node of this directory.
      * The parent of the root is the root itself.
@@ -52,6 +52,24 @@
 #include "exception/EmulationWarning.hxx"
 #include "exception/FatalEmulationError.hxx"
 
+// Without the debugger, the instructions are dispatched through a table of label
+// addresses (a GCC / Clang extension), and each instruction jumps directly to the
+// next one.  Define M6502_SWITCH_DISPATCH to use the portable switch instead.
+#if defined(__GNUC__) && !defined(DEBUGGER_SUPPORT) && !defined(M6502_SWITCH_DISPATCH)
+  #define M6502_THREADED_DISPATCH
+
+  #define M6502_INSTRUCTION(_opcode) opcode_##_opcode:
+  #define M6502_END_INSTRUCTION goto instructionDone;
+
+  // '__extension__' keeps -pedantic builds (libretro) quiet
+  #define M6502_LABEL(_opcode) __extension__ &&opcode_##_opcode
+  #define M6502_DISPATCH_ROW(_h) \
+    M6502_LABEL(0x##_h##0), M6502_LABEL(0x##_h##1), M6502_LABEL(0x##_h##2), M6502_LABEL(0x##_h##3), \
+    M6502_LABEL(0x##_h##4), M6502_LABEL(0x##_h##5), M6502_LABEL(0x##_h##6), M6502_LABEL(0x##_h##7), \
+    M6502_LABEL(0x##_h##8), M6502_LABEL(0x##_h##9), M6502_LABEL(0x##_h##a), M6502_LABEL(0x##_h##b), \
+    M6502_LABEL(0x##_h##c), M6502_LABEL(0x##_h##d), M6502_LABEL(0x##_h##e), M6502_LABEL(0x##_h##f)
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502::M6502(const Settings& settings)
   : myExecutionStatus(0),
@@ -73,6 +91,7 @@ M6502::M6502(const Settings& settings)
     myLastSrcAddressX(-1),
     myLastSrcAddressY(-1),
     myDataAddressForPoke(0),
+    myTrackDistinctAccesses(false),
     myOnHaltCallback(nullptr),
     myHaltRequested(false),
     myGhostReadsTrap(false),
@@ -137,7 +156,7 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 
   ////////////////////////////////////////////////
   // TODO - move this logic directly into CartAR
-  if(address != myLastAddress)
+  if(myTrackDistinctAccesses && address != myLastAddress)
   {
     ++myNumberOfDistinctAccesses;
     myLastAddress = address;
@@ -145,11 +164,14 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
   ////////////////////////////////////////////////
   mySystem->incrementCycles(SYSTEM_CYCLES_PER_CPU);
   icycles += SYSTEM_CYCLES_PER_CPU;
+#ifdef DEBUGGER_SUPPORT
   myFlags = flags;
+#endif
   uInt8 result = mySystem->peek(address, flags);
-  myLastPeekAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
+  myLastPeekAddress = address;
+
   if(myReadTraps.isInitialized() && myReadTraps.isSet(address)
      && (myGhostReadsTrap || flags != DISASM_NONE))
   {
@@ -175,7 +197,7 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
 {
   ////////////////////////////////////////////////
   // TODO - move this logic directly into CartAR
-  if(address != myLastAddress)
+  if(myTrackDistinctAccesses && address != myLastAddress)
   {
     ++myNumberOfDistinctAccesses;
     myLastAddress = address;
@@ -184,9 +206,10 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
   mySystem->incrementCycles(SYSTEM_CYCLES_PER_CPU);
   icycles += SYSTEM_CYCLES_PER_CPU;
   mySystem->poke(address, value, flags);
-  myLastPokeAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
+  myLastPokeAddress = address;
+
   if(myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
   {
     myLastPokeBaseAddress = myDebugger->getBaseAddress(myLastPokeAddress, false); // mirror handling
@@ -312,10 +335,42 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
       uInt16 operandAddress = 0, intermediateAddress = 0;
       uInt8 operand = 0;
 
+  #ifdef DEBUGGER_SUPPORT
       // Reset the peek/poke address pointers
       myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0;
+  #endif
 
       try {
+    #ifdef M6502_THREADED_DISPATCH
+        static const void* const dispatchTable[256] = {
+          M6502_DISPATCH_ROW(0), M6502_DISPATCH_ROW(1), M6502_DISPATCH_ROW(2), M6502_DISPATCH_ROW(3),
+          M6502_DISPATCH_ROW(4), M6502_DISPATCH_ROW(5), M6502_DISPATCH_ROW(6), M6502_DISPATCH_ROW(7),
+          M6502_DISPATCH_ROW(8), M6502_DISPATCH_ROW(9), M6502_DISPATCH_ROW(a), M6502_DISPATCH_ROW(b),
+          M6502_DISPATCH_ROW(c), M6502_DISPATCH_ROW(d), M6502_DISPATCH_ROW(e), M6502_DISPATCH_ROW(f)
+        };
+
+      nextInstruction:
+        icycles = 0;
+
+        // Fetch instruction at the program counter
+        IR = peek(PC++, DISASM_CODE);  // This address represents a code section
+
+        // Jump to the code that executes the instruction
+      #pragma GCC diagnostic push
+      #pragma GCC diagnostic ignored "-Wpedantic"
+        goto *dispatchTable[IR];
+      #pragma GCC diagnostic pop
+
+        // 6502 instruction emulation is generated by an M4 macro file
+        #include "M6502.ins"
+
+      instructionDone:
+        // Continue with the next instruction unless execution was stopped or
+        // the timeslice is exhausted
+        if(!myExecutionStatus &&
+           mySystem->cycles() - previousCycles < cycles * SYSTEM_CYCLES_PER_CPU)
+          goto nextInstruction;
+    #else
         icycles = 0;
     #ifdef DEBUGGER_SUPPORT
         uInt16 oldPC = PC;
@@ -333,6 +388,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           default:
             FatalEmulationError::raise("invalid instruction");
         }
+    #endif
 
     #ifdef DEBUGGER_SUPPORT
         if(myReadFromWritePortBreak)
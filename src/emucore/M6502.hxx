@@ -191,6 +191,15 @@ class M6502 : public Serializable
     */
     uInt32 distinctAccesses() const { return myNumberOfDistinctAccesses; }
 
+    /**
+      Enable or disable counting the accesses to distinct memory locations.
+      This is only needed by some cartridges (see distinctAccesses()), so it
+      is disabled by default.
+
+      @param enable  Whether to count the accesses
+    */
+    void trackDistinctAccesses(bool enable) { myTrackDistinctAccesses = enable; }
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -386,6 +395,9 @@ class M6502 : public Serializable
     /// is set to zero
     uInt16 myDataAddressForPoke;
 
+    /// Indicates whether the accesses to distinct memory locations are counted
+    bool myTrackDistinctAccesses;
+
     /// Indicates the number of system cycles per processor cycle
     static constexpr uInt32 SYSTEM_CYCLES_PER_CPU = 1;
 
@@ -21,6 +21,11 @@
   Recompile with the following:
     'm4 M6502.m4 > M6502.ins'
 
+  Each instruction starts with M6502_INSTRUCTION(opcode) and ends with
+  M6502_END_INSTRUCTION.  By default these expand to the 'case' and 'break'
+  of a switch statement; M6502.cxx redefines them to build a threaded
+  (computed goto) dispatcher instead.
+
   @author  Bradford W. Mott and Stephen Anthony
 */
 
@@ -52,6 +57,14 @@
   #endif
 #endif
 
+#ifndef M6502_INSTRUCTION
+  #define M6502_INSTRUCTION(_opcode) case _opcode:
+#endif
+
+#ifndef M6502_END_INSTRUCTION
+  #define M6502_END_INSTRUCTION break;
+#endif
+
 
 define(M6502_IMPLIED, `{
   peek(PC, DISASM_NONE);
@@ -1009,1333 +1022,1350 @@ define(M6502_TYA, `{
 
 //////////////////////////////////////////////////
 // ADC
-case 0x69:
+M6502_INSTRUCTION(0x69)
 M6502_IMMEDIATE_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x65:
+M6502_INSTRUCTION(0x65)
 M6502_ZERO_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x75:
+M6502_INSTRUCTION(0x75)
 M6502_ZEROX_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x6d:
+M6502_INSTRUCTION(0x6d)
 M6502_ABSOLUTE_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x7d:
+M6502_INSTRUCTION(0x7d)
 M6502_ABSOLUTEX_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x79:
+M6502_INSTRUCTION(0x79)
 M6502_ABSOLUTEY_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x61:
+M6502_INSTRUCTION(0x61)
 M6502_INDIRECTX_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
-case 0x71:
+M6502_INSTRUCTION(0x71)
 M6502_INDIRECTY_READ
 M6502_ADC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ASR
-case 0x4b:
+M6502_INSTRUCTION(0x4b)
 M6502_IMMEDIATE_READ
 M6502_ASR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ANC
-case 0x0b:
-case 0x2b:
+M6502_INSTRUCTION(0x0b)
+M6502_INSTRUCTION(0x2b)
 M6502_IMMEDIATE_READ
 M6502_ANC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // AND
-case 0x29:
+M6502_INSTRUCTION(0x29)
 M6502_IMMEDIATE_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x25:
+M6502_INSTRUCTION(0x25)
 M6502_ZERO_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x35:
+M6502_INSTRUCTION(0x35)
 M6502_ZEROX_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x2d:
+M6502_INSTRUCTION(0x2d)
 M6502_ABSOLUTE_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x3d:
+M6502_INSTRUCTION(0x3d)
 M6502_ABSOLUTEX_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x39:
+M6502_INSTRUCTION(0x39)
 M6502_ABSOLUTEY_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x21:
+M6502_INSTRUCTION(0x21)
 M6502_INDIRECTX_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
-case 0x31:
+M6502_INSTRUCTION(0x31)
 M6502_INDIRECTY_READ
 M6502_AND
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ANE
-case 0x8b:
+M6502_INSTRUCTION(0x8b)
 M6502_IMMEDIATE_READ
 M6502_ANE
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ARR
-case 0x6b:
+M6502_INSTRUCTION(0x6b)
 M6502_IMMEDIATE_READ
 M6502_ARR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ASL
-case 0x0a:
+M6502_INSTRUCTION(0x0a)
 M6502_IMPLIED
 M6502_ASLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x06:
+M6502_INSTRUCTION(0x06)
 M6502_ZERO_READMODIFYWRITE
 M6502_ASL
-break;
+M6502_END_INSTRUCTION
 
-case 0x16:
+M6502_INSTRUCTION(0x16)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ASL
-break;
+M6502_END_INSTRUCTION
 
-case 0x0e:
+M6502_INSTRUCTION(0x0e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ASL
-break;
+M6502_END_INSTRUCTION
 
-case 0x1e:
+M6502_INSTRUCTION(0x1e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ASL
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // BIT
-case 0x24:
+M6502_INSTRUCTION(0x24)
 M6502_ZERO_READ
 M6502_BIT
-break;
+M6502_END_INSTRUCTION
 
-case 0x2C:
+M6502_INSTRUCTION(0x2c)
 M6502_ABSOLUTE_READ
 M6502_BIT
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // Branches
-case 0x90:
+M6502_INSTRUCTION(0x90)
 M6502_IMMEDIATE_READ
 M6502_BCC
-break;
+M6502_END_INSTRUCTION
 
 
-case 0xb0:
+M6502_INSTRUCTION(0xb0)
 M6502_IMMEDIATE_READ
 M6502_BCS
-break;
+M6502_END_INSTRUCTION
 
 
-case 0xf0:
+M6502_INSTRUCTION(0xf0)
 M6502_IMMEDIATE_READ
 M6502_BEQ
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x30:
+M6502_INSTRUCTION(0x30)
 M6502_IMMEDIATE_READ
 M6502_BMI
-break;
+M6502_END_INSTRUCTION
 
 
-case 0xD0:
+M6502_INSTRUCTION(0xd0)
 M6502_IMMEDIATE_READ
 M6502_BNE
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x10:
+M6502_INSTRUCTION(0x10)
 M6502_IMMEDIATE_READ
 M6502_BPL
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x50:
+M6502_INSTRUCTION(0x50)
 M6502_IMMEDIATE_READ
 M6502_BVC
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x70:
+M6502_INSTRUCTION(0x70)
 M6502_IMMEDIATE_READ
 M6502_BVS
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // BRK
-case 0x00:
+M6502_INSTRUCTION(0x00)
 M6502_BRK
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CLC
-case 0x18:
+M6502_INSTRUCTION(0x18)
 M6502_IMPLIED
 M6502_CLC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CLD
-case 0xd8:
+M6502_INSTRUCTION(0xd8)
 M6502_IMPLIED
 M6502_CLD
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CLI
-case 0x58:
+M6502_INSTRUCTION(0x58)
 M6502_IMPLIED
 M6502_CLI
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CLV
-case 0xb8:
+M6502_INSTRUCTION(0xb8)
 M6502_IMPLIED
 M6502_CLV
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CMP
-case 0xc9:
+M6502_INSTRUCTION(0xc9)
 M6502_IMMEDIATE_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xc5:
+M6502_INSTRUCTION(0xc5)
 M6502_ZERO_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xd5:
+M6502_INSTRUCTION(0xd5)
 M6502_ZEROX_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xcd:
+M6502_INSTRUCTION(0xcd)
 M6502_ABSOLUTE_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xdd:
+M6502_INSTRUCTION(0xdd)
 M6502_ABSOLUTEX_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xd9:
+M6502_INSTRUCTION(0xd9)
 M6502_ABSOLUTEY_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xc1:
+M6502_INSTRUCTION(0xc1)
 M6502_INDIRECTX_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
-case 0xd1:
+M6502_INSTRUCTION(0xd1)
 M6502_INDIRECTY_READ
 M6502_CMP
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CPX
-case 0xe0:
+M6502_INSTRUCTION(0xe0)
 M6502_IMMEDIATE_READ
 M6502_CPX
-break;
+M6502_END_INSTRUCTION
 
-case 0xe4:
+M6502_INSTRUCTION(0xe4)
 M6502_ZERO_READ
 M6502_CPX
-break;
+M6502_END_INSTRUCTION
 
-case 0xec:
+M6502_INSTRUCTION(0xec)
 M6502_ABSOLUTE_READ
 M6502_CPX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // CPY
-case 0xc0:
+M6502_INSTRUCTION(0xc0)
 M6502_IMMEDIATE_READ
 M6502_CPY
-break;
+M6502_END_INSTRUCTION
 
-case 0xc4:
+M6502_INSTRUCTION(0xc4)
 M6502_ZERO_READ
 M6502_CPY
-break;
+M6502_END_INSTRUCTION
 
-case 0xcc:
+M6502_INSTRUCTION(0xcc)
 M6502_ABSOLUTE_READ
 M6502_CPY
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // DCP
-case 0xcf:
+M6502_INSTRUCTION(0xcf)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xdf:
+M6502_INSTRUCTION(0xdf)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xdb:
+M6502_INSTRUCTION(0xdb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xc7:
+M6502_INSTRUCTION(0xc7)
 M6502_ZERO_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xd7:
+M6502_INSTRUCTION(0xd7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xc3:
+M6502_INSTRUCTION(0xc3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
-case 0xd3:
+M6502_INSTRUCTION(0xd3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_DCP
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // DEC
-case 0xc6:
+M6502_INSTRUCTION(0xc6)
 M6502_ZERO_READMODIFYWRITE
 M6502_DEC
-break;
+M6502_END_INSTRUCTION
 
-case 0xd6:
+M6502_INSTRUCTION(0xd6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DEC
-break;
+M6502_END_INSTRUCTION
 
-case 0xce:
+M6502_INSTRUCTION(0xce)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DEC
-break;
+M6502_END_INSTRUCTION
 
-case 0xde:
+M6502_INSTRUCTION(0xde)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DEC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // DEX
-case 0xca:
+M6502_INSTRUCTION(0xca)
 M6502_IMPLIED
 M6502_DEX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // DEY
-case 0x88:
+M6502_INSTRUCTION(0x88)
 M6502_IMPLIED
 M6502_DEY
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // EOR
-case 0x49:
+M6502_INSTRUCTION(0x49)
 M6502_IMMEDIATE_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x45:
+M6502_INSTRUCTION(0x45)
 M6502_ZERO_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x55:
+M6502_INSTRUCTION(0x55)
 M6502_ZEROX_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x4d:
+M6502_INSTRUCTION(0x4d)
 M6502_ABSOLUTE_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x5d:
+M6502_INSTRUCTION(0x5d)
 M6502_ABSOLUTEX_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x59:
+M6502_INSTRUCTION(0x59)
 M6502_ABSOLUTEY_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x41:
+M6502_INSTRUCTION(0x41)
 M6502_INDIRECTX_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
-case 0x51:
+M6502_INSTRUCTION(0x51)
 M6502_INDIRECTY_READ
 M6502_EOR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // INC
-case 0xe6:
+M6502_INSTRUCTION(0xe6)
 M6502_ZERO_READMODIFYWRITE
 M6502_INC
-break;
+M6502_END_INSTRUCTION
 
-case 0xf6:
+M6502_INSTRUCTION(0xf6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_INC
-break;
+M6502_END_INSTRUCTION
 
-case 0xee:
+M6502_INSTRUCTION(0xee)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_INC
-break;
+M6502_END_INSTRUCTION
 
-case 0xfe:
+M6502_INSTRUCTION(0xfe)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_INC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // INX
-case 0xe8:
+M6502_INSTRUCTION(0xe8)
 M6502_IMPLIED
 M6502_INX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // INY
-case 0xc8:
+M6502_INSTRUCTION(0xc8)
 M6502_IMPLIED
 M6502_INY
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ISB
-case 0xef:
+M6502_INSTRUCTION(0xef)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xff:
+M6502_INSTRUCTION(0xff)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xfb:
+M6502_INSTRUCTION(0xfb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xe7:
+M6502_INSTRUCTION(0xe7)
 M6502_ZERO_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xf7:
+M6502_INSTRUCTION(0xf7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xe3:
+M6502_INSTRUCTION(0xe3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
-case 0xf3:
+M6502_INSTRUCTION(0xf3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_ISB
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // JMP
-case 0x4c:
+M6502_INSTRUCTION(0x4c)
 M6502_ABSOLUTE_WRITE
 M6502_JMP
-break;
+M6502_END_INSTRUCTION
 
-case 0x6c:
+M6502_INSTRUCTION(0x6c)
 M6502_INDIRECT
 M6502_JMP
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // JSR
-case 0x20:
+M6502_INSTRUCTION(0x20)
 M6502_JSR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // LAS
-case 0xbb:
+M6502_INSTRUCTION(0xbb)
 M6502_ABSOLUTEY_READ
 M6502_LAS
-break;
+M6502_END_INSTRUCTION
 
 
 //////////////////////////////////////////////////
 // LAX
-case 0xaf:
+M6502_INSTRUCTION(0xaf)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 
-case 0xbf:
+M6502_INSTRUCTION(0xbf)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 
-case 0xa7:
+M6502_INSTRUCTION(0xa7)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 
-case 0xb7:
+M6502_INSTRUCTION(0xb7)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)  // TODO - check this
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 
-case 0xa3:
+M6502_INSTRUCTION(0xa3)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 
-case 0xb3:
+M6502_INSTRUCTION(0xb3)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDA
-case 0xa9:
+M6502_INSTRUCTION(0xa9)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xa5:
+M6502_INSTRUCTION(0xa5)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xb5:
+M6502_INSTRUCTION(0xb5)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xad:
+M6502_INSTRUCTION(0xad)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xbd:
+M6502_INSTRUCTION(0xbd)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xb9:
+M6502_INSTRUCTION(0xb9)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xa1:
+M6502_INSTRUCTION(0xa1)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 
-case 0xb1:
+M6502_INSTRUCTION(0xb1)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDX
-case 0xa2:
+M6502_INSTRUCTION(0xa2)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressX)
 M6502_LDX
-break;
+M6502_END_INSTRUCTION
 
-case 0xa6:
+M6502_INSTRUCTION(0xa6)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+M6502_END_INSTRUCTION
 
-case 0xb6:
+M6502_INSTRUCTION(0xb6)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+M6502_END_INSTRUCTION
 
-case 0xae:
+M6502_INSTRUCTION(0xae)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+M6502_END_INSTRUCTION
 
-case 0xbe:
+M6502_INSTRUCTION(0xbe)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDY
-case 0xa0:
+M6502_INSTRUCTION(0xa0)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressY)
 M6502_LDY
-break;
+M6502_END_INSTRUCTION
 
-case 0xa4:
+M6502_INSTRUCTION(0xa4)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+M6502_END_INSTRUCTION
 
-case 0xb4:
+M6502_INSTRUCTION(0xb4)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+M6502_END_INSTRUCTION
 
-case 0xac:
+M6502_INSTRUCTION(0xac)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+M6502_END_INSTRUCTION
 
-case 0xbc:
+M6502_INSTRUCTION(0xbc)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // LSR
-case 0x4a:
+M6502_INSTRUCTION(0x4a)
 M6502_IMPLIED
 M6502_LSRA
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x46:
+M6502_INSTRUCTION(0x46)
 M6502_ZERO_READMODIFYWRITE
 M6502_LSR
-break;
+M6502_END_INSTRUCTION
 
-case 0x56:
+M6502_INSTRUCTION(0x56)
 M6502_ZEROX_READMODIFYWRITE
 M6502_LSR
-break;
+M6502_END_INSTRUCTION
 
-case 0x4e:
+M6502_INSTRUCTION(0x4e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_LSR
-break;
+M6502_END_INSTRUCTION
 
-case 0x5e:
+M6502_INSTRUCTION(0x5e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_LSR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // LXA
-case 0xab:
+M6502_INSTRUCTION(0xab)
 M6502_IMMEDIATE_READ
 M6502_LXA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // NOP
-case 0x1a:
-case 0x3a:
-case 0x5a:
-case 0x7a:
-case 0xda:
-case 0xea:
-case 0xfa:
+M6502_INSTRUCTION(0x1a)
+M6502_INSTRUCTION(0x3a)
+M6502_INSTRUCTION(0x5a)
+M6502_INSTRUCTION(0x7a)
+M6502_INSTRUCTION(0xda)
+M6502_INSTRUCTION(0xea)
+M6502_INSTRUCTION(0xfa)
 M6502_IMPLIED
 M6502_NOP
-break;
+M6502_END_INSTRUCTION
 
-case 0x80:
-case 0x82:
-case 0x89:
-case 0xc2:
-case 0xe2:
+M6502_INSTRUCTION(0x80)
+M6502_INSTRUCTION(0x82)
+M6502_INSTRUCTION(0x89)
+M6502_INSTRUCTION(0xc2)
+M6502_INSTRUCTION(0xe2)
 M6502_IMMEDIATE_READ
 M6502_NOP
-break;
+M6502_END_INSTRUCTION
 
-case 0x04:
-case 0x44:
-case 0x64:
+M6502_INSTRUCTION(0x04)
+M6502_INSTRUCTION(0x44)
+M6502_INSTRUCTION(0x64)
 M6502_ZERO_READ
 M6502_NOP
-break;
-
-case 0x14:
-case 0x34:
-case 0x54:
-case 0x74:
-case 0xd4:
-case 0xf4:
+M6502_END_INSTRUCTION
+
+M6502_INSTRUCTION(0x14)
+M6502_INSTRUCTION(0x34)
+M6502_INSTRUCTION(0x54)
+M6502_INSTRUCTION(0x74)
+M6502_INSTRUCTION(0xd4)
+M6502_INSTRUCTION(0xf4)
 M6502_ZEROX_READ
 M6502_NOP
-break;
+M6502_END_INSTRUCTION
 
-case 0x0c:
+M6502_INSTRUCTION(0x0c)
 M6502_ABSOLUTE_READ
 M6502_NOP
-break;
-
-case 0x1c:
-case 0x3c:
-case 0x5c:
-case 0x7c:
-case 0xdc:
-case 0xfc:
+M6502_END_INSTRUCTION
+
+M6502_INSTRUCTION(0x1c)
+M6502_INSTRUCTION(0x3c)
+M6502_INSTRUCTION(0x5c)
+M6502_INSTRUCTION(0x7c)
+M6502_INSTRUCTION(0xdc)
+M6502_INSTRUCTION(0xfc)
 M6502_ABSOLUTEX_READ
 M6502_NOP
-break;
+M6502_END_INSTRUCTION
 
 
 //////////////////////////////////////////////////
 // ORA
-case 0x09:
+M6502_INSTRUCTION(0x09)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x05:
+M6502_INSTRUCTION(0x05)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x15:
+M6502_INSTRUCTION(0x15)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x0d:
+M6502_INSTRUCTION(0x0d)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x1d:
+M6502_INSTRUCTION(0x1d)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x19:
+M6502_INSTRUCTION(0x19)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x01:
+M6502_INSTRUCTION(0x01)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x11:
+M6502_INSTRUCTION(0x11)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // PHA
-case 0x48:
+M6502_INSTRUCTION(0x48)
 M6502_IMPLIED
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_PHA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // PHP
-case 0x08:
+M6502_INSTRUCTION(0x08)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PHP
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // PLA
-case 0x68:
+M6502_INSTRUCTION(0x68)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // PLP
-case 0x28:
+M6502_INSTRUCTION(0x28)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLP
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // RLA
-case 0x2f:
+M6502_INSTRUCTION(0x2f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x3f:
+M6502_INSTRUCTION(0x3f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x3b:
+M6502_INSTRUCTION(0x3b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x27:
+M6502_INSTRUCTION(0x27)
 M6502_ZERO_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x37:
+M6502_INSTRUCTION(0x37)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x23:
+M6502_INSTRUCTION(0x23)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x33:
+M6502_INSTRUCTION(0x33)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RLA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ROL
-case 0x2a:
+M6502_INSTRUCTION(0x2a)
 M6502_IMPLIED
 M6502_ROLA
-break;
+M6502_END_INSTRUCTION
 
-case 0x26:
+M6502_INSTRUCTION(0x26)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROL
-break;
+M6502_END_INSTRUCTION
 
-case 0x36:
+M6502_INSTRUCTION(0x36)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROL
-break;
+M6502_END_INSTRUCTION
 
-case 0x2e:
+M6502_INSTRUCTION(0x2e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROL
-break;
+M6502_END_INSTRUCTION
 
-case 0x3e:
+M6502_INSTRUCTION(0x3e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROL
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // ROR
-case 0x6a:
+M6502_INSTRUCTION(0x6a)
 M6502_IMPLIED
 M6502_RORA
-break;
+M6502_END_INSTRUCTION
 
-case 0x66:
+M6502_INSTRUCTION(0x66)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROR
-break;
+M6502_END_INSTRUCTION
 
-case 0x76:
+M6502_INSTRUCTION(0x76)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROR
-break;
+M6502_END_INSTRUCTION
 
-case 0x6e:
+M6502_INSTRUCTION(0x6e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROR
-break;
+M6502_END_INSTRUCTION
 
-case 0x7e:
+M6502_INSTRUCTION(0x7e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROR
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // RRA
-case 0x6f:
+M6502_INSTRUCTION(0x6f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x7f:
+M6502_INSTRUCTION(0x7f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x7b:
+M6502_INSTRUCTION(0x7b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x67:
+M6502_INSTRUCTION(0x67)
 M6502_ZERO_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x77:
+M6502_INSTRUCTION(0x77)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x63:
+M6502_INSTRUCTION(0x63)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
-case 0x73:
+M6502_INSTRUCTION(0x73)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RRA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // RTI
-case 0x40:
+M6502_INSTRUCTION(0x40)
 M6502_IMPLIED
 M6502_RTI
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // RTS
-case 0x60:
+M6502_INSTRUCTION(0x60)
 M6502_IMPLIED
 M6502_RTS
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SAX
-case 0x8f:
+M6502_INSTRUCTION(0x8f)
 M6502_ABSOLUTE_WRITE
 M6502_SAX
-break;
+M6502_END_INSTRUCTION
 
-case 0x87:
+M6502_INSTRUCTION(0x87)
 M6502_ZERO_WRITE
 M6502_SAX
-break;
+M6502_END_INSTRUCTION
 
-case 0x97:
+M6502_INSTRUCTION(0x97)
 M6502_ZEROY_WRITE
 M6502_SAX
-break;
+M6502_END_INSTRUCTION
 
-case 0x83:
+M6502_INSTRUCTION(0x83)
 M6502_INDIRECTX_WRITE
 M6502_SAX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SBC
-case 0xe9:
-case 0xeb:
+M6502_INSTRUCTION(0xe9)
+M6502_INSTRUCTION(0xeb)
 M6502_IMMEDIATE_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xe5:
+M6502_INSTRUCTION(0xe5)
 M6502_ZERO_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xf5:
+M6502_INSTRUCTION(0xf5)
 M6502_ZEROX_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xed:
+M6502_INSTRUCTION(0xed)
 M6502_ABSOLUTE_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xfd:
+M6502_INSTRUCTION(0xfd)
 M6502_ABSOLUTEX_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xf9:
+M6502_INSTRUCTION(0xf9)
 M6502_ABSOLUTEY_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xe1:
+M6502_INSTRUCTION(0xe1)
 M6502_INDIRECTX_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
-case 0xf1:
+M6502_INSTRUCTION(0xf1)
 M6502_INDIRECTY_READ
 M6502_SBC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SBX
-case 0xcb:
+M6502_INSTRUCTION(0xcb)
 M6502_IMMEDIATE_READ
 M6502_SBX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SEC
-case 0x38:
+M6502_INSTRUCTION(0x38)
 M6502_IMPLIED
 M6502_SEC
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SED
-case 0xf8:
+M6502_INSTRUCTION(0xf8)
 M6502_IMPLIED
 M6502_SED
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SEI
-case 0x78:
+M6502_INSTRUCTION(0x78)
 M6502_IMPLIED
 M6502_SEI
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SHA
-case 0x9f:
+M6502_INSTRUCTION(0x9f)
 M6502_ABSOLUTEY_WRITE
 M6502_SHA
-break;
+M6502_END_INSTRUCTION
 
-case 0x93:
+M6502_INSTRUCTION(0x93)
 M6502_INDIRECTY_WRITE
 M6502_SHA
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SHS
-case 0x9b:
+M6502_INSTRUCTION(0x9b)
 M6502_ABSOLUTEY_WRITE
 M6502_SHS
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SHX
-case 0x9e:
+M6502_INSTRUCTION(0x9e)
 M6502_ABSOLUTEY_WRITE
 M6502_SHX
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SHY
-case 0x9c:
+M6502_INSTRUCTION(0x9c)
 M6502_ABSOLUTEX_WRITE
 M6502_SHY
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SLO
-case 0x0f:
+M6502_INSTRUCTION(0x0f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x1f:
+M6502_INSTRUCTION(0x1f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x1b:
+M6502_INSTRUCTION(0x1b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x07:
+M6502_INSTRUCTION(0x07)
 M6502_ZERO_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x17:
+M6502_INSTRUCTION(0x17)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x03:
+M6502_INSTRUCTION(0x03)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
-case 0x13:
+M6502_INSTRUCTION(0x13)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SLO
-break;
+M6502_END_INSTRUCTION
 
 //////////////////////////////////////////////////
 // SRE
-case 0x4f:
+M6502_INSTRUCTION(0x4f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x5f:
+M6502_INSTRUCTION(0x5f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x5b:
+M6502_INSTRUCTION(0x5b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x47:
+M6502_INSTRUCTION(0x47)
 M6502_ZERO_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x57:
+M6502_INSTRUCTION(0x57)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x43:
+M6502_INSTRUCTION(0x43)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
-case 0x53:
+M6502_INSTRUCTION(0x53)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SRE
-break;
+M6502_END_INSTRUCTION
 
 
 //////////////////////////////////////////////////
 // STA
-case 0x85:
+M6502_INSTRUCTION(0x85)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x95:
+M6502_INSTRUCTION(0x95)
 M6502_ZEROX_WRITE
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x8d:
+M6502_INSTRUCTION(0x8d)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x9d:
+M6502_INSTRUCTION(0x9d)
 M6502_ABSOLUTEX_WRITE
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x99:
+M6502_INSTRUCTION(0x99)
 M6502_ABSOLUTEY_WRITE
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x81:
+M6502_INSTRUCTION(0x81)
 M6502_INDIRECTX_WRITE
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 
-case 0x91:
+M6502_INSTRUCTION(0x91)
 M6502_INDIRECTY_WRITE
 M6502_STA
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STX
-case 0x86:
+M6502_INSTRUCTION(0x86)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressX)
 M6502_STX
-break;
+M6502_END_INSTRUCTION
 
-case 0x96:
+M6502_INSTRUCTION(0x96)
 M6502_ZEROY_WRITE
 M6502_STX
-break;
+M6502_END_INSTRUCTION
 
-case 0x8e:
+M6502_INSTRUCTION(0x8e)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressX)
 M6502_STX
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STY
-case 0x84:
+M6502_INSTRUCTION(0x84)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressY)
 M6502_STY
-break;
+M6502_END_INSTRUCTION
 
-case 0x94:
+M6502_INSTRUCTION(0x94)
 M6502_ZEROX_WRITE
 M6502_STY
-break;
+M6502_END_INSTRUCTION
 
-case 0x8c:
+M6502_INSTRUCTION(0x8c)
 M6502_ABSOLUTE_WRITE
 SET_LAST_POKE(myLastSrcAddressY)
 M6502_STY
-break;
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // Remaining MOVE opcodes
-case 0xaa:
+M6502_INSTRUCTION(0xaa)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressA)
 M6502_TAX
-break;
+M6502_END_INSTRUCTION
 
 
-case 0xa8:
+M6502_INSTRUCTION(0xa8)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressY, myLastSrcAddressA)
 M6502_TAY
-break;
+M6502_END_INSTRUCTION
 
 
-case 0xba:
+M6502_INSTRUCTION(0xba)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressS)
 M6502_TSX
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x8a:
+M6502_INSTRUCTION(0x8a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressX)
 M6502_TXA
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x9a:
+M6502_INSTRUCTION(0x9a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressS, myLastSrcAddressX)
 M6502_TXS
-break;
+M6502_END_INSTRUCTION
 
 
-case 0x98:
+M6502_INSTRUCTION(0x98)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressY)
 M6502_TYA
-break;
+M6502_END_INSTRUCTION
+
+//////////////////////////////////////////////////
+// KIL (invalid, halts the processor)
+M6502_INSTRUCTION(0x02)
+M6502_INSTRUCTION(0x12)
+M6502_INSTRUCTION(0x22)
+M6502_INSTRUCTION(0x32)
+M6502_INSTRUCTION(0x42)
+M6502_INSTRUCTION(0x52)
+M6502_INSTRUCTION(0x62)
+M6502_INSTRUCTION(0x72)
+M6502_INSTRUCTION(0x92)
+M6502_INSTRUCTION(0xb2)
+M6502_INSTRUCTION(0xd2)
+M6502_INSTRUCTION(0xf2)
+FatalEmulationError::raise("invalid instruction");
+M6502_END_INSTRUCTION
 //////////////////////////////////////////////////
@@ -177,23 +177,33 @@ void M6532::installDelegate(System& system, Device& device)
   //    (addr & 0x0200) == 0x0200 is IO     (A9 is 1)
   //    (addr & 0x0300) == 0x0100 is Stack  (A8 is 1, A9 is 0)
   //    (addr & 0x0300) == 0x0000 is ZP RAM (A8 is 0, A9 is 0)
+  // When the RIOT is installed by itself, the pages of the ZP RAM (and its
+  // mirrors) are accessed directly, as the RAM doesn't depend on the timer
+  // being up to date; devices delegating to the RIOT see all accesses
   for (uInt16 addr = 0; addr < 0x1000; addr += System::PAGE_SIZE)
     if ((addr & 0x0080) == 0x0080) {
-      mySystem->setPageAccess(addr, access);
+      if (&device == this && (addr & 0x0200) == 0x0000) {
+        System::PageAccess ramAccess(access);
+        ramAccess.directPeekBase = ramAccess.directPokeBase = &myRAM[addr & 0x007f];
+        mySystem->setPageAccess(addr, ramAccess);
+      }
+      else
+        mySystem->setPageAccess(addr, access);
     }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 M6532::peek(uInt16 addr)
 {
-  updateEmulation();
-
   // A9 distinguishes I/O registers from ZP RAM
   // A9 = 1 is read from I/O
   // A9 = 0 is read from RAM
   if((addr & 0x0200) == 0x0000)
     return myRAM[addr & 0x007f];
 
+  // Only the I/O registers need the timer to catch up with the CPU
+  updateEmulation();
+
   switch(addr & 0x07)
   {
     case 0x00:    // SWCHA - Port A I/O Register (Joystick)
@@ -254,8 +264,6 @@ uInt8 M6532::peek(uInt16 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6532::poke(uInt16 addr, uInt8 value)
 {
-  updateEmulation();
-
   // A9 distinguishes I/O registers from ZP RAM
   // A9 = 1 is write to I/O
   // A9 = 0 is write to RAM
@@ -265,6 +273,9 @@ bool M6532::poke(uInt16 addr, uInt8 value)
     return true;
   }
 
+  // Only the I/O registers need the timer to catch up with the CPU
+  updateEmulation();
+
   // A2 distinguishes I/O registers from the timer
   // A2 = 1 is write to timer
   // A2 = 0 is write to I/O
@@ -129,6 +129,7 @@ class M6532 : public Device
       @return  Pointer to RAM array.
     */
     const uInt8* getRAM() const { return myRAM; }
+    uInt8* getRAM() { return myRAM; }
 
   private:
 
@@ -336,18 +336,18 @@ string hash(const uInt8* buffer, uInt32 length)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const FilesystemNode& node)
 {
-  ByteBuffer image;
+  MappedData data;
   uInt32 size = 0;
   try
   {
-    size = node.read(image);
+    size = node.map(data);
   }
   catch(...)
   {
     return EmptyString;
   }
 
-  const string& md5 = hash(image, size);
+  const string& md5 = hash(data.get(), size);
   return md5;
 }
 
@@ -51,6 +51,8 @@
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "DetectionCache.hxx"
+#include "RomIndex.hxx"
 #include "EventHandler.hxx"
 #include "PNGLibrary.hxx"
 #include "Console.hxx"
@@ -110,6 +112,7 @@ OSystem::OSystem()
   mySettings = MediaFactory::createSettings();
 
   myPropSet = make_unique<PropertiesSet>();
+  myDetectionCache = make_unique<DetectionCache>();
 
   Logger::instance().setLogCallback(
     std::bind(&OSystem::logMessage, this, std::placeholders::_1, std::placeholders::_2)
@@ -185,6 +188,7 @@ bool OSystem::create()
 #endif
 
   myPropSet->load(myPropertiesFile);
+  myDetectionCache->load(myDetectionCacheFile);
 
   return true;
 }
@@ -221,6 +225,7 @@ void OSystem::loadConfig(const Settings::Options& options)
 #endif
 
   mySettings->setRepository(createSettingsRepository());
+  myRomIndex = make_unique<RomIndex>(createRomIndexRepository());
 
   Logger::log("Loading config options ...", 2);
   mySettings->load(options);
@@ -249,6 +254,12 @@ void OSystem::saveConfig()
 
   if(myPropSet && myPropSet->save(myPropertiesFile))
     Logger::log("Saving properties set ...", 2);
+
+  if(myDetectionCache && myDetectionCache->save(myDetectionCacheFile))
+    Logger::log("Saving detection cache ...", 2);
+
+  if(myRomIndex)
+    myRomIndex->flush();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -283,6 +294,7 @@ void OSystem::setConfigPaths()
   myCheatFile = FilesystemNode(myBaseDir + "stella.cht").getPath();
   myPaletteFile = FilesystemNode(myBaseDir + "stella.pal").getPath();
   myPropertiesFile = FilesystemNode(myBaseDir + "stella.pro").getPath();
+  myDetectionCacheFile = FilesystemNode(myBaseDir + "stella.det").getPath();
 
 #if 0
   // Debug code
@@ -519,11 +531,15 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
 {
   unique_ptr<Console> console;
 
-  // Open the cartridge image and read it in
-  ByteBuffer image;
+  // Open the cartridge image; the cartridge needs its own (modifiable) copy
+  MappedData data;
   uInt32 size = 0;
-  if((image = openROM(romfile, md5, size)) != nullptr)
+  if((data = openROM(romfile, md5, size)) != nullptr)
   {
+    ByteBuffer image = make_unique<uInt8[]>(size);
+    std::copy_n(data.get(), size, image.get());
+    data.reset();
+
     // Get a valid set of properties, including any entered on the commandline
     // For initial creation of the Cart, we're only concerned with the BS type
     Properties props;
@@ -599,22 +615,22 @@ void OSystem::closeConsole()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ByteBuffer OSystem::openROM(const FilesystemNode& rom, string& md5, uInt32& size)
+MappedData OSystem::openROM(const FilesystemNode& rom, string& md5, uInt32& size)
 {
   // This method has a documented side-effect:
   // It not only loads a ROM and creates an array with its contents,
   // but also adds a properties entry if the one for the ROM doesn't
   // contain a valid name
 
-  ByteBuffer image;
-  if((size = rom.read(image)) == 0)
+  MappedData image;
+  if((size = rom.map(image)) == 0)
     return nullptr;
 
   // If we get to this point, we know we have a valid file to open
   // Now we make sure that the file has a valid properties entry
   // To save time, only generate an MD5 if we really need one
   if(md5 == "")
-    md5 = MD5::hash(image, size);
+    md5 = MD5::hash(image.get(), size);
 
   // Some games may not have a name, since there may not
   // be an entry in stella.pro.  In that case, we use the rom name
@@ -796,6 +812,19 @@ shared_ptr<KeyValueRepository> OSystem::createSettingsRepository()
   #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepository> OSystem::createRomIndexRepository()
+{
+  // Without a database, the index is only kept for the current session
+  #ifdef SQLITE_SUPPORT
+    return mySettingsDb
+      ? shared_ptr<KeyValueRepository>(mySettingsDb, &mySettingsDb->romIndexRepository())
+      : make_shared<KeyValueRepositoryNoop>();
+  #else
+    return make_shared<KeyValueRepositoryNoop>();
+  #endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string OSystem::ourOverrideBaseDir = "";
 bool OSystem::ourOverrideBaseDirWithApp = false;
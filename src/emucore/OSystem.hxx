@@ -23,6 +23,8 @@ class FrameBuffer;
 class EventHandler;
 class Properties;
 class PropertiesSet;
+class DetectionCache;
+class RomIndex;
 class Random;
 class Sound;
 class StateManager;
@@ -130,6 +132,20 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of frame layout and YStart autodetection results.
+
+      @return The detection cache object
+    */
+    DetectionCache& detectionCache() const { return *myDetectionCache; }
+
+    /**
+      Get the index of MD5s and other info of the ROM files seen so far.
+
+      @return The ROM index object
+    */
+    RomIndex& romIndex() const { return *myRomIndex; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -301,18 +317,18 @@ class OSystem
     const string& defaultLoadDir() const { return myDefaultLoadDir; }
 
     /**
-      Open the given ROM and return an array containing its contents.
+      Open the given ROM and return its (read-only) contents.
       Also, the properties database is updated with a valid ROM name
       for this ROM (if necessary).
 
       @param rom    The file node of the ROM to open (contains path)
       @param md5    The md5 calculated from the ROM file
                     (will be recalculated if necessary)
-      @param size   The amount of data read into the image array
+      @param size   The amount of data available in the image
 
-      @return  Unique pointer to the array
+      @return  Pointer to the (usually memory-mapped) image
     */
-    ByteBuffer openROM(const FilesystemNode& rom, string& md5, uInt32& size);
+    MappedData openROM(const FilesystemNode& rom, string& md5, uInt32& size);
 
     /**
       Creates a new game console from the specified romfile, and correctly
@@ -430,6 +446,8 @@ class OSystem
 
     virtual shared_ptr<KeyValueRepository> createSettingsRepository();
 
+    virtual shared_ptr<KeyValueRepository> createRomIndexRepository();
+
     /**
       Append a message to the internal log
       (a newline is automatically added).
@@ -483,6 +501,12 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the DetectionCache object
+    unique_ptr<DetectionCache> myDetectionCache;
+
+    // Pointer to the RomIndex object
+    unique_ptr<RomIndex> myRomIndex;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -549,6 +573,7 @@ class OSystem
     string myConfigFile;
     string myPaletteFile;
     string myPropertiesFile;
+    string myDetectionCacheFile;
 
     FilesystemNode myRomFile;
     string myRomMD5;
@@ -15,8 +15,11 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <mutex>
+#include <thread>
 
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
@@ -37,11 +40,73 @@
 #include "Joystick.hxx"
 #include "Random.hxx"
 #include "DispatchResult.hxx"
+#include "AudioQueue.hxx"
 
 using namespace std::chrono;
 
 namespace {
   static constexpr uInt32 RUNTIME_DEFAULT = 60;
+  static constexpr uInt32 FRAMES_DEFAULT = 600;
+  static constexpr uInt32 AUDIO_QUEUE_CAPACITY = 16;
+
+  // Events that can be referred to by name in golden mode input scripts
+  static const std::pair<const char*, Event::Type> inputEvents[] = {
+    { "ConsoleColor",       Event::ConsoleColor       },
+    { "ConsoleBlackWhite",  Event::ConsoleBlackWhite  },
+    { "ConsoleLeftDiffA",   Event::ConsoleLeftDiffA   },
+    { "ConsoleLeftDiffB",   Event::ConsoleLeftDiffB   },
+    { "ConsoleRightDiffA",  Event::ConsoleRightDiffA  },
+    { "ConsoleRightDiffB",  Event::ConsoleRightDiffB  },
+    { "ConsoleSelect",      Event::ConsoleSelect      },
+    { "ConsoleReset",       Event::ConsoleReset       },
+    { "JoystickZeroUp",     Event::JoystickZeroUp     },
+    { "JoystickZeroDown",   Event::JoystickZeroDown   },
+    { "JoystickZeroLeft",   Event::JoystickZeroLeft   },
+    { "JoystickZeroRight",  Event::JoystickZeroRight  },
+    { "JoystickZeroFire",   Event::JoystickZeroFire   },
+    { "JoystickOneUp",      Event::JoystickOneUp      },
+    { "JoystickOneDown",    Event::JoystickOneDown    },
+    { "JoystickOneLeft",    Event::JoystickOneLeft    },
+    { "JoystickOneRight",   Event::JoystickOneRight   },
+    { "JoystickOneFire",    Event::JoystickOneFire    }
+  };
+
+  // A fast, endian-independent 64 bit hash (FNV-1a on 64 bit words)
+  class Hash {
+    public:
+      void add(uInt64 word) {
+        myState = (myState ^ word) * 0x100000001b3ULL;
+      }
+
+      void add(const uInt8* data, size_t size) {
+        for (; size >= 8; data += 8, size -= 8)
+          add(
+            uInt64(data[0])       | uInt64(data[1]) << 8  | uInt64(data[2]) << 16 |
+            uInt64(data[3]) << 24 | uInt64(data[4]) << 32 | uInt64(data[5]) << 40 |
+            uInt64(data[6]) << 48 | uInt64(data[7]) << 56
+          );
+
+        for (; size > 0; data++, size--) add(*data);
+      }
+
+      void add(const Int16* data, size_t size) {
+        for (; size > 0; data++, size--) add(uInt16(*data));
+      }
+
+      uInt64 value() const {
+        // Final avalanche, so that single bit differences affect the whole hash
+        uInt64 h = myState;
+
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+
+        return h;
+      }
+
+    private:
+      uInt64 myState{0xcbf29ce484222325ULL};
+  };
 
   void updateProgress(uInt32 from, uInt32 to) {
     while (from < to) {
@@ -53,83 +118,267 @@ namespace {
       from++;
     }
   }
+
+  void collectFiles(const FilesystemNode& dir, vector<string>& files) {
+    FSList children;
+    if (!dir.getChildren(children, FilesystemNode::ListMode::All)) return;
+
+    for (const FilesystemNode& child : children) {
+      if (child.isDirectory()) collectFiles(child, files);
+      else if (child.isFile()) files.push_back(child.getPath());
+    }
+  }
+
+  string jsonString(const string& s) {
+    ostringstream buf;
+    buf << '"';
+
+    for (char c : s) {
+      switch (c) {
+        case '"':  buf << "\\\""; break;
+        case '\\': buf << "\\\\"; break;
+        case '\n': buf << "\\n";  break;
+        case '\r': buf << "\\r";  break;
+        case '\t': buf << "\\t";  break;
+        default:
+          if (uInt8(c) < 0x20)
+            buf << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+          else
+            buf << c;
+      }
+    }
+
+    buf << '"';
+    return buf.str();
+  }
+
+  double perSecond(uInt64 count, double seconds) {
+    return seconds > 0 ? count / seconds : 0;
+  }
 }
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns(std::max(argc - 2, 0))
+  : myMode(Mode::profile),
+    myJobs(std::max(std::thread::hardware_concurrency(), 1u)),
+    myUpdateGolden(false)
 {
-  for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
+  if (argc > 1 && string(argv[1]) == "-batch") myMode = Mode::batch;
+  if (argc > 1 && string(argv[1]) == "-golden") myMode = Mode::golden;
 
+  for (int i = 2; i < argc; i++) {
     string arg = argv[i];
-    size_t splitPoint = arg.find_first_of(":");
-
-    run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
 
-    if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
-    else  {
-      int runtime = atoi(arg.substr(splitPoint+1, string::npos).c_str());
-      run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
+    if (myMode != Mode::profile && arg == "-jobs" && i + 1 < argc) {
+      int jobs = atoi(argv[++i]);
+      if (jobs > 0) myJobs = jobs;
     }
+    else if (myMode != Mode::profile && arg == "-json" && i + 1 < argc)
+      myJsonFile = argv[++i];
+    else if (myMode == Mode::golden && arg == "-input" && i + 1 < argc)
+      myInputFile = argv[++i];
+    else if (myMode == Mode::golden && arg == "-dir" && i + 1 < argc)
+      myGoldenDir = argv[++i];
+    else if (myMode == Mode::golden && arg == "-update")
+      myUpdateGolden = true;
+    else
+      addRun(arg);
   }
 
   mySettings.setValue("fastscbios", true);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::addRun(const string& arg)
+{
+  const uInt32 runtimeDefault = myMode == Mode::golden ? FRAMES_DEFAULT : RUNTIME_DEFAULT;
+
+  ProfilingRun run;
+  size_t splitPoint = arg.find_first_of(":");
+
+  run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+
+  if (splitPoint == string::npos) run.runtime = runtimeDefault;
+  else  {
+    int runtime = atoi(arg.substr(splitPoint+1, string::npos).c_str());
+    run.runtime = runtime > 0 ? runtime : runtimeDefault;
+  }
+
+  if (myMode != Mode::profile) {
+    FilesystemNode node(run.romFile);
+
+    if (node.isDirectory()) {
+      vector<string> files;
+      collectFiles(node, files);
+      std::sort(files.begin(), files.end());
+
+      for (const string& file : files)
+        if (!BSPF::endsWithIgnoreCase(file, ".golden"))
+          profilingRuns.push_back({file, run.runtime});
+
+      return;
+    }
+  }
+
+  profilingRuns.push_back(run);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::run()
+{
+  switch (myMode) {
+    case Mode::profile:
+      return runProfile();
+
+    case Mode::batch:
+      return runBatch();
+
+    case Mode::golden:
+      return loadInput() && runBatch();
+  }
+
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runProfile()
 {
   cout << "Profiling Stella..." << endl;
 
   for (ProfilingRun& run : profilingRuns) {
     cout << endl << "running " << run.romFile << " for " << run.runtime << " seconds..." << endl;
 
-    if (!runOne(run)) return false;
+    ProfilingResult result;
+    if (!runOne(run, mySettings, result, true)) return false;
   }
 
   return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ProfilingRunner::runOne(const ProfilingRun run)
+bool ProfilingRunner::runBatch()
 {
-  FilesystemNode imageFile(run.romFile);
+  uInt32 jobs = std::min(myJobs, std::max(uInt32(profilingRuns.size()), 1u));
+
+  cout << "Running " << profilingRuns.size() << " ROMs on " << jobs << " threads..." << endl;
+
+  vector<ProfilingResult> results(profilingRuns.size());
+  std::atomic<size_t> nextRun(0);
+  size_t finishedRuns = 0;
+  std::mutex outputMutex;
+
+  // Each worker claims the next pending run and emulates it on a System of its own,
+  // so the only shared state is the job counter and the console
+  auto worker = [&]() {
+    size_t i;
+
+    while ((i = nextRun++) < profilingRuns.size()) {
+      const ProfilingRun& run(profilingRuns[i]);
+      ProfilingResult& result(results[i]);
+
+      Settings settings;
+      settings.setValue("fastscbios", true);
+
+      try {
+        runOne(run, settings, result, false);
+      }
+      catch (const runtime_error& e) {
+        result.ok = false;
+        result.error = e.what();
+      }
+
+      std::lock_guard<std::mutex> lock(outputMutex);
+
+      cout << "[" << ++finishedRuns << "/" << profilingRuns.size() << "] " << run.romFile << ": ";
+      if (result.ok && myMode == Mode::golden)
+        cout << (myUpdateGolden ? "updated " : "matches ") << goldenFile(run)
+             << " (" << result.frames << " frames)" << endl;
+      else if (result.ok)
+        cout << std::fixed << std::setprecision(1)
+             << perSecond(result.frames, result.realtime) << " frames/s, "
+             << perSecond(result.cycles, result.realtime) / 1e6 << " MHz" << endl;
+      else
+        cout << "ERROR: " << result.error << endl;
+    }
+  };
 
-  if (!imageFile.isFile()) {
-    cout << "ERROR: " << run.romFile << " is not a ROM image" << endl;
-    return false;
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  vector<std::thread> threads;
+  for (uInt32 i = 0; i < jobs; i++) threads.emplace_back(worker);
+  for (std::thread& thread : threads) thread.join();
+
+  double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+
+  uInt64 frames = 0, cycles = 0;
+  uInt32 failed = 0;
+  for (const ProfilingResult& result : results) {
+    frames += result.frames;
+    cycles += result.cycles;
+    if (!result.ok) failed++;
+  }
+
+  cout << endl << std::fixed << std::setprecision(1)
+       << "total: " << frames << " frames, " << cycles << " cycles in "
+       << realtimeUsed << " seconds (" << perSecond(frames, realtimeUsed) << " frames/s, "
+       << perSecond(cycles, realtimeUsed) / 1e6 << " MHz)" << endl;
+  if (failed > 0) cout << failed << " ROMs failed" << endl;
+
+  if (myJsonFile == "-")
+    writeJson(cout, results, jobs, realtimeUsed);
+  else if (myJsonFile != "") {
+    ofstream out(myJsonFile);
+    if (!out) {
+      cout << "ERROR: unable to write " << myJsonFile << endl;
+      return false;
+    }
+    writeJson(out, results, jobs, realtimeUsed);
   }
 
+  return failed == 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runOne(const ProfilingRun run, Settings& settings,
+                             ProfilingResult& result, bool verbose) const
+{
+  auto fail = [&](const string& error) {
+    if (verbose) cout << "ERROR: " << error << endl;
+    result.error = error;
+
+    return false;
+  };
+
+  FilesystemNode imageFile(run.romFile);
+
+  if (!imageFile.isFile()) return fail(run.romFile + " is not a ROM image");
+
   ByteBuffer image;
   uInt32 size = imageFile.read(image);
-  if (size == 0) {
-    cout << "ERROR: unable to read " << run.romFile << endl;
-    return false;
-  }
+  if (size == 0) return fail("unable to read " + run.romFile);
 
   string md5 = MD5::hash(image, size);
   string type = "";
-  unique_ptr<Cartridge> cartridge = CartDetector::create(imageFile, image, size, md5, type, mySettings);
+  unique_ptr<Cartridge> cartridge = CartDetector::create(imageFile, image, size, md5, type, settings);
 
-  if (!cartridge) {
-    cout << "ERROR: unable to determine cartridge type" << endl;
-    return false;
-  }
+  if (!cartridge) return fail("unable to determine cartridge type");
+
+  result.md5 = md5;
+  result.type = cartridge->detectedType();
 
   IO consoleIO;
   Random rng(0);
   Event event;
 
-  M6502 cpu(mySettings);
-  M6532 riot(consoleIO, mySettings);
-  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, mySettings);
+  M6502 cpu(settings);
+  M6532 riot(consoleIO, settings);
+  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, settings);
   System system(rng, cpu, riot, tia, *cartridge);
 
   consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
   consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
-  consoleIO.mySwitches = make_unique<Switches>(event, myProps, mySettings);
+  consoleIO.mySwitches = make_unique<Switches>(event, myProps, settings);
 
   tia.bindToControllers();
   cartridge->setStartBankFromPropsFunc([]() { return -1; });
@@ -139,7 +388,7 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
   tia.setFrameManager(&frameLayoutDetector);
   system.reset();
 
-  (cout << "detecting frame layout... ").flush();
+  if (verbose) (cout << "detecting frame layout... ").flush();
   for(int i = 0; i < 60; ++i) tia.update();
 
   FrameLayout frameLayout = frameLayoutDetector.detectedLayout();
@@ -147,27 +396,28 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
 
   switch (frameLayout) {
     case FrameLayout::ntsc:
-      cout << "NTSC";
+      result.layout = "NTSC";
       consoleTiming = ConsoleTiming::ntsc;
       break;
 
     case FrameLayout::pal:
-      cout << "PAL";
+      result.layout = "PAL";
       consoleTiming = ConsoleTiming::pal;
       break;
   }
 
-  (cout << endl).flush();
+  if (verbose) (cout << result.layout << endl).flush();
 
   YStartDetector ystartDetector;
   tia.setFrameManager(&ystartDetector);
   system.reset();
 
-  (cout << "detecting ystart... ").flush();
+  if (verbose) (cout << "detecting ystart... ").flush();
   for (int i = 0; i < 80; i++) tia.update();
 
   uInt32 yStart = ystartDetector.detectedYStart();
-  (cout << yStart << endl).flush();
+  result.yStart = yStart;
+  if (verbose) (cout << yStart << endl).flush();
 
   FrameManager frameManager;
   tia.setFrameManager(&frameManager);
@@ -177,14 +427,23 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
   system.reset();
 
   EmulationTiming emulationTiming(frameLayout, consoleTiming);
+
+  if (myMode == Mode::golden)
+    return runFrames(run, emulationTiming, tia, riot, event, result);
+
   uInt64 cycles = 0;
   uInt64 cyclesTarget = run.runtime * emulationTiming.cyclesPerSecond();
 
   DispatchResult dispatchResult;
   dispatchResult.setOk(0);
 
+  // The ARM of the Harmony/Melody runs at 70 MHz
+  constexpr double thumbClock = 70e6;
+  const uInt64 thumbCyclesStart = cartridge->thumbCycles();
+  uInt64 thumbCyclesFrame = thumbCyclesStart;
+
   uInt32 percent = 0;
-  (cout << "0%").flush();
+  if (verbose) (cout << "0%").flush();
 
   time_point<high_resolution_clock> tp = high_resolution_clock::now();
 
@@ -192,23 +451,300 @@ bool ProfilingRunner::runOne(const ProfilingRun run)
     tia.update(dispatchResult);
     cycles += dispatchResult.getCycles();
 
-    if (tia.newFramePending()) tia.renderToFrameBuffer();
+    if (tia.newFramePending()) {
+      tia.renderToFrameBuffer();
 
-    uInt32 percentNow = uInt32(std::min((100 * cycles) / cyclesTarget, static_cast<uInt64>(100)));
-    updateProgress(percent, percentNow);
+      uInt64 thumbCycles = cartridge->thumbCycles();
+      result.maxThumbCycles = std::max(result.maxThumbCycles, thumbCycles - thumbCyclesFrame);
+      thumbCyclesFrame = thumbCycles;
+    }
+
+    if (verbose) {
+      uInt32 percentNow = uInt32(std::min((100 * cycles) / cyclesTarget, static_cast<uInt64>(100)));
+      updateProgress(percent, percentNow);
 
-    percent = percentNow;
+      percent = percentNow;
+    }
   }
 
   double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
 
+  result.cycles = cycles;
+  result.frames = tia.frameCount();
+  result.realtime = realtimeUsed;
+  result.thumbCycles = cartridge->thumbCycles() - thumbCyclesStart;
+  result.thumbCyclesPerFrame = uInt64(thumbClock * emulationTiming.cyclesPerFrame() /
+                                      emulationTiming.cyclesPerSecond());
+
   if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
-    cout << endl << "ERROR: emulation failed after " << cycles << " cycles";
+    if (verbose) cout << endl;
+    return fail("emulation failed after " + std::to_string(cycles) + " cycles");
+  }
+
+  if (verbose) {
+    (cout << "100%" << endl).flush();
+    cout << "real time: " << realtimeUsed << " seconds" << endl;
+
+    if (result.thumbCycles > 0) {
+      cout << "ARM cycles per frame: " << (result.thumbCycles / std::max(result.frames, uInt64(1)))
+           << " average, " << result.maxThumbCycles << " max, "
+           << result.thumbCyclesPerFrame << " available" << endl;
+      if (result.maxThumbCycles > result.thumbCyclesPerFrame)
+        cout << "WARNING: the ARM code would overrun real hardware" << endl;
+    }
+  }
+
+  result.ok = true;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::writeJson(ostream& out, const vector<ProfilingResult>& results,
+                                uInt32 jobs, double realtime) const
+{
+  uInt64 frames = 0, cycles = 0;
+  for (const ProfilingResult& result : results) {
+    frames += result.frames;
+    cycles += result.cycles;
+  }
+
+  out << std::setprecision(6) << std::fixed
+      << "{" << endl
+      << "  \"jobs\": " << jobs << "," << endl
+      << "  \"realtime\": " << realtime << "," << endl
+      << "  \"frames\": " << frames << "," << endl
+      << "  \"cycles\": " << cycles << "," << endl
+      << "  \"framesPerSecond\": " << perSecond(frames, realtime) << "," << endl
+      << "  \"cyclesPerSecond\": " << perSecond(cycles, realtime) << "," << endl
+      << "  \"roms\": [";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const ProfilingResult& result(results[i]);
+
+    out << (i > 0 ? "," : "") << endl
+        << "    {" << endl
+        << "      \"file\": " << jsonString(profilingRuns[i].romFile) << "," << endl
+        << "      \"runtime\": " << profilingRuns[i].runtime << "," << endl
+        << "      \"ok\": " << (result.ok ? "true" : "false") << "," << endl
+        << "      \"error\": " << jsonString(result.error) << "," << endl
+        << "      \"md5\": " << jsonString(result.md5) << "," << endl
+        << "      \"type\": " << jsonString(result.type) << "," << endl
+        << "      \"layout\": " << jsonString(result.layout) << "," << endl
+        << "      \"ystart\": " << result.yStart << "," << endl
+        << "      \"frames\": " << result.frames << "," << endl
+        << "      \"cycles\": " << result.cycles << "," << endl
+        << "      \"realtime\": " << result.realtime << "," << endl
+        << "      \"framesPerSecond\": " << perSecond(result.frames, result.realtime) << "," << endl
+        << "      \"cyclesPerSecond\": " << perSecond(result.cycles, result.realtime);
+
+    if (result.thumbCycles > 0)
+      out << "," << endl
+          << "      \"thumbCycles\": " << result.thumbCycles << "," << endl
+          << "      \"maxThumbCyclesPerFrame\": " << result.maxThumbCycles << "," << endl
+          << "      \"thumbCyclesPerFrame\": " << result.thumbCyclesPerFrame;
+
+    if (myMode == Mode::golden)
+      out << "," << endl << "      \"mismatchFrame\": " << result.mismatchFrame;
+
+    out << endl << "    }";
+  }
+
+  out << endl << "  ]" << endl << "}" << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runFrames(const ProfilingRun& run, const EmulationTiming& emulationTiming,
+                                TIA& tia, M6532& riot, Event& event, ProfilingResult& result) const
+{
+  const string file = goldenFile(run);
+  vector<FrameHash> golden, hashes;
+
+  if (!myUpdateGolden) {
+    string md5;
+
+    if (!loadGolden(file, md5, golden)) {
+      result.error = "unable to read golden file " + file;
+      return false;
+    }
+    if (md5 != result.md5) {
+      result.error = file + " belongs to a different ROM";
+      return false;
+    }
+  }
+
+  shared_ptr<AudioQueue> audioQueue =
+    make_shared<AudioQueue>(emulationTiming.audioFragmentSize(), AUDIO_QUEUE_CAPACITY, false);
+  tia.setAudioQueue(audioQueue);
+
+  Int16* fragment = nullptr;
+  auto input = myInput.cbegin();
+  Hash audioHash;
+
+  DispatchResult dispatchResult;
+  dispatchResult.setOk(0);
+
+  hashes.reserve(run.runtime);
+
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  while (hashes.size() < run.runtime) {
+    const uInt32 frame = uInt32(hashes.size());
+
+    // Apply the scripted input for this frame, and latch it into the controllers
+    // and switches just like EventHandler::poll does once per frame
+    for (; input != myInput.cend() && input->frame <= frame; ++input)
+      event.set(input->type, input->value);
+    riot.update();
+
+    // Step one scanline at a time, so that no frame is skipped
+    do {
+      tia.update(dispatchResult, TIAConstants::H_CYCLES);
+      result.cycles += dispatchResult.getCycles();
+
+      if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
+        result.error = "emulation failed in frame " + std::to_string(frame);
+        return false;
+      }
+
+      for (Int16* next; (next = audioQueue->dequeue(fragment)) != nullptr; fragment = next)
+        audioHash.add(next, audioQueue->fragmentSize());
+    } while (!tia.newFramePending());
+
+    tia.renderToFrameBuffer();
+
+    Hash videoHash;
+    videoHash.add(tia.frameBufferScanlinesLastFrame());
+    videoHash.add(tia.frameBuffer(), TIAConstants::H_PIXEL * tia.frameBufferScanlinesLastFrame());
+
+    hashes.push_back({videoHash.value(), audioHash.value()});
+    audioHash = Hash();
+
+    if (!myUpdateGolden) {
+      const char* mismatch = nullptr;
+
+      if (frame >= golden.size())
+        mismatch = "golden file ends before";
+      else if (hashes[frame].video != golden[frame].video)
+        mismatch = "video mismatch in";
+      else if (hashes[frame].audio != golden[frame].audio)
+        mismatch = "audio mismatch in";
+
+      if (mismatch) {
+        result.mismatchFrame = frame;
+        result.frames = hashes.size();
+        result.error = string(mismatch) + " frame " + std::to_string(frame);
+        return false;
+      }
+    }
+  }
+
+  result.realtime = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+  result.frames = hashes.size();
+
+  if (myUpdateGolden && !saveGolden(file, result.md5, hashes)) {
+    result.error = "unable to write golden file " + file;
+    return false;
+  }
+
+  result.ok = true;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::loadInput()
+{
+  if (myInputFile == "") return true;
+
+  ifstream in(myInputFile);
+  if (!in) {
+    cout << "ERROR: unable to read " << myInputFile << endl;
     return false;
   }
 
-  (cout << "100%" << endl).flush();
-  cout << "real time: " << realtimeUsed << " seconds" << endl;
+  string line;
+  for (uInt32 lineNumber = 1; getline(in, line); lineNumber++) {
+    // Skip empty lines and comments
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == string::npos || line[start] == '#') continue;
+
+    istringstream buf(line);
+    InputEvent input;
+    string name;
+
+    if (!(buf >> input.frame >> name)) {
+      cout << "ERROR: " << myInputFile << ":" << lineNumber << ": expected 'frame event [value]'" << endl;
+      return false;
+    }
+
+    if (!(buf >> input.value)) input.value = 1;
+
+    input.type = Event::NoType;
+    for (const auto& inputEvent : inputEvents)
+      if (BSPF::equalsIgnoreCase(name, inputEvent.first)) input.type = inputEvent.second;
+
+    if (input.type == Event::NoType) {
+      int type = atoi(name.c_str());
+
+      if (type <= Event::NoType || type >= Event::LastType) {
+        cout << "ERROR: " << myInputFile << ":" << lineNumber << ": unknown event " << name << endl;
+        return false;
+      }
+      input.type = Event::Type(type);
+    }
+
+    myInput.push_back(input);
+  }
+
+  std::stable_sort(myInput.begin(), myInput.end(),
+    [](const InputEvent& a, const InputEvent& b) { return a.frame < b.frame; });
 
   return true;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ProfilingRunner::goldenFile(const ProfilingRun& run) const
+{
+  if (myGoldenDir == "") return run.romFile + ".golden";
+
+  FilesystemNode dir(myGoldenDir);
+
+  return dir.getPath() + FilesystemNode(run.romFile).getName() + ".golden";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::loadGolden(const string& file, string& md5, vector<FrameHash>& hashes) const
+{
+  ifstream in(file);
+  string line, tag;
+
+  if (!getline(in, line) || line != "# Stella golden file") return false;
+  if (!(in >> tag >> md5) || tag != "md5") return false;
+
+  uInt32 frame;
+  FrameHash hash;
+  while (in >> std::dec >> frame >> std::hex >> hash.video >> hash.audio) {
+    if (frame != hashes.size()) return false;
+
+    hashes.push_back(hash);
+  }
+
+  return in.eof();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::saveGolden(const string& file, const string& md5, const vector<FrameHash>& hashes) const
+{
+  ofstream out(file);
+  if (!out) return false;
+
+  out << "# Stella golden file" << endl
+      << "md5 " << md5 << endl
+      << std::setfill('0');
+
+  for (size_t frame = 0; frame < hashes.size(); frame++)
+    out << std::dec << frame << " "
+        << std::hex << std::setw(16) << hashes[frame].video << " "
+        << std::setw(16) << hashes[frame].audio << endl;
+
+  return bool(out);
+}
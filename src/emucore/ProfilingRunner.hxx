@@ -20,12 +20,39 @@
 
 class Control;
 class Switches;
+class EmulationTiming;
+class TIA;
+class M6532;
 
 #include "bspf.hxx"
 #include "Settings.hxx"
 #include "ConsoleIO.hxx"
 #include "Props.hxx"
-
+#include "Event.hxx"
+
+/**
+  Headless runner that emulates ROMs without an OSystem.
+
+  Two modes are supported:
+
+    stella -profile rom[:seconds] ...
+      Run each ROM in turn on the main thread and report the time used.
+
+    stella -batch [-jobs n] [-json file] rom|dir[:seconds] ...
+      Distribute all ROMs (directories are scanned recursively) over a pool
+      of 'n' worker threads (default: number of cores), each running its own
+      System.  Emulation speed is reported per ROM and in aggregate, and
+      optionally written as JSON to 'file' ('-' for stdout).
+
+    stella -golden [-update] [-jobs n] [-input file] [-dir dir] rom|dir[:frames] ...
+      Run each ROM for the given number of frames with a fixed random seed
+      and (optionally) scripted input, hash the framebuffer and the audio
+      produced in every frame and compare the hashes to those stored in the
+      golden file 'rom.golden' (in 'dir' if given).  With '-update', the
+      golden files are (re)written instead.  The input script consists of
+      lines 'frame event [value]', where event is either a name (see
+      'inputEvents' in the implementation) or a numeric Event::Type.
+*/
 class ProfilingRunner {
   public:
 
@@ -35,9 +62,45 @@ class ProfilingRunner {
 
   private:
 
+    enum class Mode { profile, batch, golden };
+
     struct ProfilingRun {
       string romFile;
-      uInt32 runtime;
+      uInt32 runtime;  // seconds, or frames in golden mode
+    };
+
+    struct InputEvent {
+      uInt32 frame;
+      Event::Type type;
+      Int32 value;
+    };
+
+    struct FrameHash {
+      uInt64 video;
+      uInt64 audio;
+    };
+
+    struct ProfilingResult {
+      bool ok{false};
+      string error;
+
+      string md5;
+      string type;
+      string layout;
+      uInt32 yStart{0};
+
+      uInt64 cycles{0};
+      uInt64 frames{0};
+      double realtime{0};
+
+      // Carts with an ARM: the ARM cycles run in total, in the busiest frame,
+      // and available per frame on real hardware
+      uInt64 thumbCycles{0};
+      uInt64 maxThumbCycles{0};
+      uInt64 thumbCyclesPerFrame{0};
+
+      // Golden mode: first frame that does not match the golden file
+      Int32 mismatchFrame{-1};
     };
 
     struct IO: public ConsoleIO {
@@ -52,12 +115,45 @@ class ProfilingRunner {
 
   private:
 
-    bool runOne(const ProfilingRun run);
+    void addRun(const string& arg);
+
+    bool runProfile();
+
+    bool runBatch();
+
+    bool runOne(const ProfilingRun run, Settings& settings,
+                ProfilingResult& result, bool verbose) const;
+
+    bool runFrames(const ProfilingRun& run, const EmulationTiming& emulationTiming,
+                   TIA& tia, M6532& riot, Event& event, ProfilingResult& result) const;
+
+    bool loadInput();
+
+    string goldenFile(const ProfilingRun& run) const;
+
+    bool loadGolden(const string& file, string& md5, vector<FrameHash>& hashes) const;
+
+    bool saveGolden(const string& file, const string& md5, const vector<FrameHash>& hashes) const;
+
+    void writeJson(ostream& out, const vector<ProfilingResult>& results,
+                   uInt32 jobs, double realtime) const;
 
   private:
 
+    Mode myMode;
+
     vector<ProfilingRun> profilingRuns;
 
+    // Batch and golden mode only: number of worker threads and JSON report destination
+    uInt32 myJobs;
+    string myJsonFile;
+
+    // Golden mode only: scripted input, golden file directory and update flag
+    string myInputFile;
+    vector<InputEvent> myInput;
+    string myGoldenDir;
+    bool myUpdateGolden;
+
     Settings mySettings;
 
     Properties myProps;
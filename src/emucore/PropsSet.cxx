@@ -15,7 +15,9 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 
 #include "bspf.hxx"
 #include "FSNode.hxx"
@@ -38,6 +40,7 @@ bool PropertiesSet::save(const string& filename) const
 {
   // Only save properties when it won't create an empty file
   FilesystemNode props(filename);
+  std::lock_guard<std::mutex> lock(myMutex);
   if(!props.exists() && myExternalProps.size() == 0)
     return false;
 
@@ -55,6 +58,15 @@ bool PropertiesSet::save(const string& filename) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PropertiesSet::getMD5(const string& md5, Properties& properties,
                            bool useDefaults) const
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  return findMD5(md5, properties, useDefaults);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PropertiesSet::findMD5(const string& md5, Properties& properties,
+                            bool useDefaults) const
 {
   properties.setDefaults();
   bool found = false;
@@ -91,26 +103,20 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
   // Otherwise, search the internal database using binary search
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    uInt64 hi, lo;
+    if(parseMD5(md5, hi, lo))
     {
-      int i = (low + high) / 2;
-      int cmp = BSPF::compareIgnoreCase(md5,
-          DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)]);
+      const auto* end = DefPropsMD5 + DEF_PROPS_SIZE;
+      const auto* item = std::lower_bound(DefPropsMD5, end, hi,
+          [lo](const uInt64 (&key)[2], uInt64 h) {
+            return key[0] < h || (key[0] == h && key[1] < lo);
+          });
 
-      if(cmp == 0)  // found it
+      if(item != end && (*item)[0] == hi && (*item)[1] == lo)  // found it
       {
-        for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropType(p), DefProps[i][p]);
-
+        setBuiltIn(uInt32(item - DefPropsMD5), properties);
         found = true;
-        break;
       }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
     }
   }
 
@@ -148,11 +154,13 @@ void PropertiesSet::insert(const Properties& properties, bool save)
   if(md5 == "")
     return;
 
+  std::lock_guard<std::mutex> lock(myMutex);
+
   // Make sure the exact entry isn't already in any list
   Properties defaultProps;
-  if(getMD5(md5, defaultProps, false) && defaultProps == properties)
+  if(findMD5(md5, defaultProps, false) && defaultProps == properties)
     return;
-  else if(getMD5(md5, defaultProps, true) && defaultProps == properties)
+  else if(findMD5(md5, defaultProps, true) && defaultProps == properties)
   {
     myExternalProps.erase(md5);
     return;
@@ -181,21 +189,21 @@ void PropertiesSet::print() const
   // This isn't fast, but I suspect this method isn't used too often (or at all)
 
   // First insert all external props
+  std::unique_lock<std::mutex> lock(myMutex);
   PropsList list = myExternalProps;
+  lock.unlock();
 
   // Now insert all the built-in ones
   // Note that if we try to insert a duplicate, the insertion will fail
   // This is fine, since a duplicate in the built-in list means it should
   // be overrided anyway (and insertion shouldn't be done)
   Properties properties;
-  for(int i = 0; i < DEF_PROPS_SIZE; ++i)
+  for(uInt32 i = 0; i < DEF_PROPS_SIZE; ++i)
   {
     properties.setDefaults();
-    for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropType(p), DefProps[i][p]);
+    setBuiltIn(i, properties);
 
-    list.emplace(DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)], properties);
+    list.emplace(properties.get(PropType::Cart_MD5), properties);
   }
 
   // Now, print the resulting list
@@ -203,3 +211,33 @@ void PropertiesSet::print() const
   for(const auto& i: list)
     i.second.print();
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PropertiesSet::parseMD5(const string& md5, uInt64& hi, uInt64& lo)
+{
+  if(md5.length() != 32)
+    return false;
+
+  hi = lo = 0;
+  for(uInt32 i = 0; i < 32; ++i)
+  {
+    const char c = md5[i];
+    uInt64 nibble;
+    if(c >= '0' && c <= '9')       nibble = c - '0';
+    else if(c >= 'a' && c <= 'f')  nibble = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F')  nibble = c - 'A' + 10;
+    else                           return false;
+
+    uInt64& half = i < 16 ? hi : lo;
+    half = (half << 4) | nibble;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PropertiesSet::setBuiltIn(uInt32 item, Properties& properties)
+{
+  for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
+    if(DefProps[item][p] != 0)
+      properties.set(PropType(p), DefPropsStrings[DefProps[item][p]]);
+}
@@ -19,6 +19,7 @@
 #define PROPERTIES_SET_HXX
 
 #include <map>
+#include <mutex>
 
 class FilesystemNode;
 class OSystem;
@@ -34,6 +35,9 @@ class OSystem;
   the game rom image (essentially a different game) and this would
   necessitate a new entry in the stella.pro file anyway.
 
+  Properties may be looked up from other threads (ie, by the launcher
+  while preparing information about ROMs in the background).
+
   @author  Stephen Anthony
 */
 class PropertiesSet
@@ -106,6 +110,27 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Get the property from the set with the given MD5; see getMD5().
+      The caller must hold the lock.
+    */
+    bool findMD5(const string& md5, Properties& properties,
+                 bool useDefaults) const;
+
+    /**
+      Convert an md5sum in hex notation (any case) into its numeric value,
+      as used as key of the built-in database.
+
+      @return  False if the string isn't a valid md5sum
+    */
+    static bool parseMD5(const string& md5, uInt64& hi, uInt64& lo);
+
+    /**
+      Set all (non-default) properties of the given built-in item.
+    */
+    static void setBuiltIn(uInt32 item, Properties& properties);
+
   private:
     using PropsList = std::map<string, Properties>;
 
@@ -116,6 +141,9 @@ class PropertiesSet
     // be discarded when the program ends
     PropsList myTempProps;
 
+    // Guards both lists, for lookups from other threads
+    mutable std::mutex myMutex;
+
   private:
     // Following constructors and assignment operators not supported
     PropertiesSet(const PropertiesSet&) = delete;
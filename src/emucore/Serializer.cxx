@@ -23,7 +23,14 @@ using std::ios_base;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(const string& filename, Mode m)
-  : myStream(nullptr)
+  : myStream(nullptr),
+    myInMemory(false),
+    myFixedSize(false),
+    myData(nullptr),
+    myCapacity(0),
+    myDataSize(0),
+    myReadPos(0),
+    myWritePos(0)
 {
   if(m == Mode::ReadOnly)
   {
@@ -66,39 +73,105 @@ Serializer::Serializer(const string& filename, Mode m)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer()
-  : myStream(nullptr)
+  : myStream(nullptr),
+    myInMemory(true),
+    myFixedSize(false),
+    myData(nullptr),
+    myCapacity(0),
+    myDataSize(0),
+    myReadPos(0),
+    myWritePos(0)
 {
-  myStream = make_unique<stringstream>(ios::in | ios::out | ios::binary);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(uInt8* data, size_t capacity)
+  : myStream(nullptr),
+    myInMemory(true),
+    myFixedSize(true),
+    myData(data),
+    myCapacity(capacity),
+    myDataSize(0),
+    myReadPos(0),
+    myWritePos(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(const uInt8* data, size_t size)
+  : myStream(nullptr),
+    myInMemory(true),
+    myFixedSize(true),
+    myData(const_cast<uInt8*>(data)),  // never written, since capacity is 0
+    myCapacity(0),
+    myDataSize(size),
+    myReadPos(0),
+    myWritePos(0)
+{
+}
 
-  // For some reason, Windows and possibly macOS needs to store something in
-  // the stream before it is used for the first time
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::rewind()
+{
   if(myStream)
   {
-    myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
-    putBool(true);
-    rewind();
+    myStream->clear();
+    myStream->seekg(ios_base::beg);
+    myStream->seekp(ios_base::beg);
   }
+  else
+    myReadPos = myWritePos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Serializer::rewind()
+size_t Serializer::size() const
 {
-  myStream->clear();
-  myStream->seekg(ios_base::beg);
-  myStream->seekp(ios_base::beg);
+  return myStream ? size_t(myStream->tellp()) : myWritePos;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-size_t Serializer::size() const
+inline void Serializer::read(void* data, size_t size) const
 {
-  return myStream->tellp();
+  if(myStream)
+    myStream->read(static_cast<char*>(data), size);
+  else
+  {
+    if(size > myDataSize - myReadPos)
+      throw runtime_error("Serializer: read past end of data");
+
+    memcpy(data, myData + myReadPos, size);
+    myReadPos += size;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Serializer::write(const void* data, size_t size)
+{
+  if(myStream)
+    myStream->write(static_cast<const char*>(data), size);
+  else
+  {
+    if(size > myCapacity - myWritePos)
+    {
+      if(myFixedSize)
+        throw runtime_error("Serializer: write past end of buffer");
+
+      myBuffer.resize(std::max(myWritePos + size, 2 * myBuffer.size()));
+      myData = myBuffer.data();
+      myCapacity = myBuffer.size();
+    }
+
+    memcpy(myData + myWritePos, data, size);
+    myWritePos += size;
+    myDataSize = std::max(myDataSize, myWritePos);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
   char buf;
-  myStream->read(&buf, 1);
+  read(&buf, 1);
 
   return buf;
 }
@@ -106,14 +179,14 @@ uInt8 Serializer::getByte() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getByteArray(uInt8* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), size);
+  read(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt16 Serializer::getShort() const
 {
   uInt16 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt16));
+  read(&val, sizeof(uInt16));
 
   return val;
 }
@@ -121,14 +194,14 @@ uInt16 Serializer::getShort() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getShortArray(uInt16* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt16)*size);
+  read(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Serializer::getInt() const
 {
   uInt32 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt32));
+  read(&val, sizeof(uInt32));
 
   return val;
 }
@@ -136,14 +209,14 @@ uInt32 Serializer::getInt() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getIntArray(uInt32* array, uInt32 size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt32)*size);
+  read(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 Serializer::getLong() const
 {
   uInt64 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt64));
+  read(&val, sizeof(uInt64));
 
   return val;
 }
@@ -152,7 +225,7 @@ uInt64 Serializer::getLong() const
 double Serializer::getDouble() const
 {
   double val = 0.0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(double));
+  read(&val, sizeof(double));
 
   return val;
 }
@@ -163,7 +236,7 @@ string Serializer::getString() const
   int len = getInt();
   string str;
   str.resize(len);
-  myStream->read(&str[0], len);
+  read(&str[0], len);
 
   return str;
 }
@@ -177,49 +250,49 @@ bool Serializer::getBool() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByte(uInt8 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), 1);
+  write(&value, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByteArray(const uInt8* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), size);
+  write(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShort(uInt16 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt16));
+  write(&value, sizeof(uInt16));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShortArray(const uInt16* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt16)*size);
+  write(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(uInt32 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt32));
+  write(&value, sizeof(uInt32));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putIntArray(const uInt32* array, uInt32 size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt32)*size);
+  write(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putLong(uInt64 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt64));
+  write(&value, sizeof(uInt64));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putDouble(double value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(double));
+  write(&value, sizeof(double));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -227,7 +300,7 @@ void Serializer::putString(const string& str)
 {
   uInt32 len = uInt32(str.length());
   putInt(len);
-  myStream->write(str.data(), len);
+  write(str.data(), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
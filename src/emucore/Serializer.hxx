@@ -23,7 +23,11 @@
 /**
   This class implements a Serializer device, whereby data is serialized and
   read from/written to a binary stream in a system-independent way.  The
-  stream can be either an actual file, or an in-memory structure.
+  stream can be either an actual file, or an in-memory structure.  The latter
+  is a flat buffer that is only ever grown, so an in-memory Serializer can be
+  rewound and reused for many states without further allocations.  It can
+  also be a fixed-size buffer owned by the caller, which is then read from
+  or written to directly.
 
   Bytes are written as characters, shorts as 2 characters (16-bits),
   integers as 4 characters (32-bits), long integers as 8 bytes (64-bits),
@@ -52,12 +56,33 @@ class Serializer
     Serializer(const string& filename, Mode m = Mode::ReadWrite);
     Serializer();
 
+    /**
+      Creates a new Serializer device on a buffer owned by the caller,
+      which must outlive the Serializer.  The buffer is never grown;
+      writing past its end throws an exception, just like reading past
+      the end of the data.
+
+      @param data      The buffer to write to, and read back from
+      @param capacity  The size of the buffer
+    */
+    Serializer(uInt8* data, size_t capacity);
+
+    /**
+      Creates a new Serializer device reading the given data, which is
+      owned by the caller and must outlive the Serializer.  It can't be
+      written to.
+
+      @param data  The serialized data
+      @param size  The size of the data
+    */
+    Serializer(const uInt8* data, size_t size);
+
   public:
     /**
       Answers whether the serializer is currently initialized for reading
       and writing.
     */
-    explicit operator bool() const { return myStream != nullptr; }
+    explicit operator bool() const { return myStream != nullptr || myInMemory; }
 
     /**
       Resets the read/write location to the beginning of the stream.
@@ -216,9 +241,28 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
+    /**
+      Read/write raw data from/to the stream or the in-memory buffer.
+    */
+    void read(void* data, size_t size) const;
+    void write(const void* data, size_t size);
+
+  private:
+    // The stream to send the serialized data to (files only).
     unique_ptr<iostream> myStream;
 
+    // In-memory data, and the current read and write positions. The read
+    // position is mutable since reading doesn't change the serialized data.
+    // The data is either in myBuffer, or in a fixed buffer of the caller.
+    bool myInMemory;
+    bool myFixedSize;
+    vector<uInt8> myBuffer;
+    uInt8* myData;
+    size_t myCapacity;
+    size_t myDataSize;
+    mutable size_t myReadPos;
+    size_t myWritePos;
+
     static constexpr uInt8 TruePattern = 0xfe, FalsePattern = 0x01;
 
   private:
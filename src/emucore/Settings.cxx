@@ -142,6 +142,7 @@ Settings::Settings()
   setPermanent("logtoconsole", "0");
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
+  setPermanent("detectcache", "true");
   setPermanent("threads", "false");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
@@ -449,6 +450,8 @@ void Settings::usage() const
     << "  -modcombo     <1|0>          Enable modifer key combos\n"
     << "                                (Control-Q for quit may not work when disabled!)\n"
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
+    << "  -detectcache  <1|0>          Reuse the display format and YStart detected\n"
+    << "                                on earlier launches of a ROM\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
@@ -317,6 +317,18 @@ class System : public Serializable
       myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT] = access;
     }
 
+    /**
+      Set the page accessing methods for consecutive pages at once.
+
+      @param addr   The address of the first page
+      @param access The accessing methods to be used by the pages
+      @param pages  The number of pages
+    */
+    void setPageAccess(uInt16 addr, const PageAccess* access, uInt16 pages) {
+      std::copy_n(access, pages,
+                  myPageAccessTable + ((addr & ADDRESS_MASK) >> PAGE_SHIFT));
+    }
+
     /**
       Get the page accessing method for the specified address.
 
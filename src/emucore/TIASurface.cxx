@@ -218,34 +218,14 @@ void TIASurface::enablePhosphor(bool enable, int blend)
 
   memset(myRGBFramebuffer, 0, sizeof(myRGBFramebuffer));
 
-  // Precalculate the average colors for the 'phosphor' effect
+  // Precalculate the decayed colors for the 'phosphor' effect
   if(myUsePhosphor)
   {
-    for(int c = 255; c >= 0; c--)
-      for(int p = 255; p >= 0; p--)
-        myPhosphorPalette[c][p] = getPhosphor(uInt8(c), uInt8(p));
-
-    myNTSCFilter.setPhosphorPalette(myPhosphorPalette);
+    myPhosphorBlend.setFactor(myPhosphorPercent);
+    myNTSCFilter.setPhosphorFactor(myPhosphorPercent);
   }
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline uInt32 TIASurface::getRGBPhosphor(const uInt32 c, const uInt32 p) const
-{
-  #define TO_RGB(color, red, green, blue) \
-    const uInt8 red = color >> 16; const uInt8 green = color >> 8; const uInt8 blue = color;
-
-  TO_RGB(c, rc, gc, bc)
-  TO_RGB(p, rp, gp, bp)
-
-  // Mix current calculated frame with previous displayed frame
-  const uInt8 rn = myPhosphorPalette[rc][rp];
-  const uInt8 gn = myPhosphorPalette[gc][gp];
-  const uInt8 bn = myPhosphorPalette[bc][bp];
-
-  return (rn << 16) | (gn << 8) | bn;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::enableNTSC(bool enable)
 {
@@ -295,25 +275,6 @@ string TIASurface::effectsInfo() const
   return buf.str();
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline uInt32 TIASurface::averageBuffers(uInt32 bufOfs)
-{
-  uInt32 c = myRGBFramebuffer[bufOfs];
-  uInt32 p = myPrevRGBFramebuffer[bufOfs];
-
-  // Split into RGB values
-  TO_RGB(c, rc, gc, bc)
-  TO_RGB(p, rp, gp, bp)
-
-  // Mix current calculated buffer with previous calculated buffer (50:50)
-  const uInt8 rn = (rc + rp) / 2;
-  const uInt8 gn = (gc + gp) / 2;
-  const uInt8 bn = (bc + bp) / 2;
-
-  // return averaged value
-  return  (rn << 16) | (gn << 8) | bn;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::render()
 {
@@ -351,18 +312,18 @@ void TIASurface::render()
       if (mySaveSnapFlag)
         memcpy(myPrevRGBFramebuffer, myRGBFramebuffer, width * height * sizeof(uInt32));
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
+      uInt32 bufofs = 0, screenofsY = 0;
       for(uInt32 y = height; y ; --y)
       {
-        pos = screenofsY;
-        for(uInt32 x = width / 2; x ; --x)
-        {
-          // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
-        }
+        uInt32* outRow = out + screenofsY;
+        for(uInt32 x = 0; x < width; ++x)
+          outRow[x] = myPalette[tiaIn[bufofs + x]];
+
+        // Store back into displayed frame buffer (for next frame)
+        myPhosphorBlend.blend(outRow, rgbIn + bufofs, width);
+        memcpy(outRow, rgbIn + bufofs, width * sizeof(uInt32));
+
+        bufofs += width;
         screenofsY += outPitch;
       }
       break;
@@ -411,7 +372,6 @@ void TIASurface::renderForSnapshot()
 
   uInt32 width = myTIA->width();
   uInt32 height = myTIA->height();
-  uInt32 pos = 0;
   uInt32 *outPtr, outPitch;
 
   myTiaSurface->basePtr(outPtr, outPitch);
@@ -431,22 +391,17 @@ void TIASurface::renderForSnapshot()
       uInt32 bufofs = 0, screenofsY = 0;
       for(uInt32 y = height; y; --y)
       {
-        pos = screenofsY;
-        for(uInt32 x = width / 2; x; --x)
-        {
-          outPtr[pos++] = averageBuffers(bufofs++);
-          outPtr[pos++] = averageBuffers(bufofs++);
-        }
+        PhosphorBlend::average(myRGBFramebuffer + bufofs, myPrevRGBFramebuffer + bufofs,
+                               outPtr + screenofsY, width);
+        bufofs += width;
         screenofsY += outPitch;
       }
       break;
     }
 
     case Filter::BlarggPhosphor:
-      uInt32 bufofs = 0;
-      for(uInt32 y = height; y; --y)
-        for(uInt32 x = outPitch; x; --x)
-          outPtr[pos++] = averageBuffers(bufofs++);
+      PhosphorBlend::average(myRGBFramebuffer, myPrevRGBFramebuffer, outPtr,
+                             height * outPitch);
       break;
   }
 
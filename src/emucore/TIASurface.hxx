@@ -28,6 +28,7 @@ class FBSurface;
 #include "Rect.hxx"
 #include "FrameBuffer.hxx"
 #include "NTSCFilter.hxx"
+#include "PhosphorBlend.hxx"
 #include "bspf.hxx"
 #include "TIAConstants.hxx"
 
@@ -107,31 +108,6 @@ class TIASurface
     void enablePhosphor(bool enable, int blend = -1);
     bool phosphorEnabled() const { return myUsePhosphor; }
 
-    /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c1  Color 1
-      @param c2  Color 2
-
-      @return  Averaged value of the two colors
-    */
-    inline uInt8 getPhosphor(const uInt8 c1, uInt8 c2) const {
-      // Use maximum of current and decayed previous values
-      c2 = uInt8(c2 * myPhosphorPercent);
-      if(c1 > c2)  return c1; // raise (assumed immediate)
-      else         return c2; // decay
-    }
-
-    /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c  RGB Color 1 (current frame)
-      @param cp RGB Color 2 (previous frame)
-
-      @return  Averaged value of the two RGB colors
-    */
-    uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
-
     /**
       Enable/disable/query NTSC filtering effects.
     */
@@ -156,12 +132,6 @@ class TIASurface
     */
     void saveSnapShot() { mySaveSnapFlag = true; }
 
-  private:
-    /**
-      Average current calculated buffer's pixel with previous calculated buffer's pixel (50:50).
-    */
-    uInt32 averageBuffers(uInt32 bufOfs);
-
   private:
     OSystem& myOSystem;
     FrameBuffer& myFB;
@@ -196,8 +166,8 @@ class TIASurface
     // Amount to blend when using phosphor effect
     float myPhosphorPercent;
 
-    // Precalculated averaged phosphor colors
-    uInt8 myPhosphorPalette[256][256];
+    // Blends the current frame into the phosphor framebuffer
+    PhosphorBlend myPhosphorBlend;
     /////////////////////////////////////////////////////////////
 
     // Use scanlines in TIA rendering mode
@@ -52,21 +52,34 @@ using Common::Base;
   #define CONV_RAMROM(d) (d)
 #endif
 
+// Wait states for an access to flash memory (with a MAMTIM of 4)
+#define FLASH_WAIT_STATES 3
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size,
                          bool traponfatal, Thumbulator::ConfigureFor configurefor,
                          Cartridge* cartridge)
   : rom(rom_ptr),
     romSize(rom_size),
-    decodedRom(new Op[romSize / 2]),
+    decodedRom(new DecodedInstruction[romSize / 2]),
     ram(ram_ptr),
+    totalCycleCount(0),
     T1TCR(0),
     T1TC(0),
     configuration(configurefor),
     myCartridge(cartridge)
 {
   for(uInt16 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]));
+    decodedRom[i] = decodeInstruction(CONV_RAMROM(rom[i]), i << 1);
+
+  // Split the code into basic blocks, by counting backwards from the
+  // instructions that end them
+  for(uInt16 i = romSize / 2; i-- > 0; )
+    if(i + 1 < romSize / 2 && !endsBlock(decodedRom[i]))
+    {
+      decodedRom[i].blockSize = decodedRom[i + 1].blockSize + 1;
+      decodedRom[i].blockCycles += decodedRom[i + 1].blockCycles;
+    }
 
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -79,14 +92,74 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size
 string Thumbulator::run()
 {
   reset();
+
+  // Where the code continues if it doesn't branch; nothing before entering
+  uInt32 nextInstructionPtr = 0;
+
   for(;;)
   {
-    if(execute()) break;
+    // The PC is always kept even by write_register (and reset)
+    const uInt32 instructionPtr = (reg_norm[15] & ~1u) - 2;
+
+    // Code in ROM is run a basic block at a time from the predecoded image;
+    // anything else (code in RAM, or an invalid address) is fetched and
+    // decoded on the fly
+    const DecodedInstruction* block;
+    bool inFlash = true;
+#ifndef UNSAFE_OPTIMIZATIONS
+    DecodedInstruction uncached;
+
+    if(instructionPtr >= 0x50 && instructionPtr < romSize)
+    {
+      block = &decodedRom[instructionPtr >> 1];
+#ifndef NO_THUMB_STATS
+      fetches += block->blockSize;
+#endif
+    }
+    else
+    {
+      uncached = decodeInstruction(fetch16(instructionPtr), instructionPtr);
+      block = &uncached;
+      inFlash = (instructionPtr & 0xF0000000) == 0;
+    }
+    instructions += block->blockSize;
+#else
+    block = &decodedRom[(instructionPtr & ROMADDMASK) >> 1];
+#ifndef NO_THUMB_STATS
+    fetches += block->blockSize;
+#endif
+#endif
+
+    // After a branch the pipeline is refilled (taking 1S + 1N more), and
+    // the fetch from flash misses the prefetch buffers of the MAM
+    const bool branched = instructionPtr != nextInstructionPtr;
+    nextInstructionPtr = instructionPtr + 2 * block->blockSize;
+
+    cycleCount += block->blockCycles;
+    if(branched)
+      cycleCount += 2;
+    if(inFlash)
+    {
+      if((mamcr & 3) == 0)
+        cycleCount += FLASH_WAIT_STATES * block->blockSize;
+      else if(branched)
+        cycleCount += FLASH_WAIT_STATES;
+    }
+
+    const DecodedInstruction* const end = block + block->blockSize;
+    int done;
+    do
+      done = execute(*block);
+    while(!done && ++block != end);
+    if(done) break;
+
 #ifndef UNSAFE_OPTIMIZATIONS
     if(instructions > 500000) // way more than would otherwise be possible
       throw runtime_error("instructions > 500000");
 #endif
   }
+  totalCycleCount += cycleCount;
+
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
@@ -267,6 +340,21 @@ void Thumbulator::write32(uInt32 addr, uInt32 data)
 #endif
   DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
+  // Fast path for RAM, writing both halfwords directly
+  if(addr >= 0x40000000 && addr <= 0x40001FFC)
+  {
+#ifndef UNSAFE_OPTIMIZATIONS
+    if(isProtected(addr+2)) fatalError("write16", addr+2, "to driver area");
+#endif
+#ifndef NO_THUMB_STATS
+    writes += 2;
+#endif
+    addr = (addr & RAMADDMASK) >> 1;
+    ram[addr]   = CONV_DATA(data);
+    ram[addr+1] = CONV_DATA(data >> 16);
+    return;
+  }
+
   switch(addr & 0xF0000000)
   {
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -399,6 +487,8 @@ uInt32 Thumbulator::read16(uInt32 addr)
   switch(addr & 0xF0000000)
   {
     case 0x00000000: //ROM
+      if((mamcr & 3) != 2)
+        cycleCount += FLASH_WAIT_STATES;
       addr &= ROMADDMASK;
       addr >>= 1;
       data = CONV_RAMROM(rom[addr]);
@@ -437,6 +527,31 @@ uInt32 Thumbulator::read32(uInt32 addr)
 #endif
 
   uInt32 data;
+
+  // Fast paths for ROM and RAM, reading both halfwords directly
+  if(addr <= ROMADDMASK - 3)
+  {
+#ifndef NO_THUMB_STATS
+    reads += 2;
+#endif
+    if((mamcr & 3) != 2)
+      cycleCount += FLASH_WAIT_STATES;
+    addr >>= 1;
+    data = CONV_RAMROM(rom[addr]) | (uInt32(CONV_RAMROM(rom[addr+1])) << 16);
+    DO_DBUG(statusMsg << "read32(" << Base::HEX8 << (addr << 1) << ")=" << Base::HEX8 << data << endl);
+    return data;
+  }
+  else if(addr >= 0x40000000 && addr <= 0x40001FFC)
+  {
+#ifndef NO_THUMB_STATS
+    reads += 2;
+#endif
+    addr = (addr & RAMADDMASK) >> 1;
+    data = CONV_RAMROM(ram[addr]) | (uInt32(CONV_RAMROM(ram[addr+1])) << 16);
+    DO_DBUG(statusMsg << "read32(" << Base::HEX8 << (addr << 1) << ")=" << Base::HEX8 << data << endl);
+    return data;
+  }
+
   switch(addr & 0xF0000000)
   {
     case 0x00000000: //ROM
@@ -800,38 +915,273 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Thumbulator::execute()
+Thumbulator::DecodedInstruction Thumbulator::decodeInstruction(uInt16 inst, uInt32 addr)
 {
-  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
+  DecodedInstruction d;
+  d.op = decodeInstructionWord(inst);
+  d.rd = d.rm = d.rn = 0;
+  d.inst = inst;
+  d.blockSize = 1;
+  d.imm = 0;
+  d.blockCycles = 1;  // 1S
+
+  // When executed, the PC already points two instructions ahead
+  const uInt32 pc = addr + 4;
+
+  switch(d.op)
+  {
+    case Op::adc:
+    case Op::and_:
+    case Op::asr2:
+    case Op::bic:
+    case Op::cpy:
+    case Op::eor:
+    case Op::lsl2:
+    case Op::lsr2:
+    case Op::mul:
+    case Op::mvn:
+    case Op::neg:
+    case Op::orr:
+    case Op::ror:
+    case Op::sbc:
+    case Op::sxtb:
+    case Op::sxth:
+    case Op::uxtb:
+    case Op::uxth:
+      d.rd = inst & 0x7;
+      d.rm = (inst >> 3) & 0x7;
+      break;
 
-  pc = read_register(15);
+    case Op::mov2:
+    case Op::rev:
+    case Op::rev16:
+    case Op::revsh:
+      d.rd = inst & 0x7;
+      d.rn = (inst >> 3) & 0x7;
+      break;
 
-  uInt32 instructionPtr = pc - 2;
-  inst = fetch16(instructionPtr);
+    case Op::cmn:
+    case Op::cmp2:
+    case Op::tst:
+      d.rn = inst & 0x7;
+      d.rm = (inst >> 3) & 0x7;
+      break;
 
-  pc += 2;
-  write_register(15, pc);
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
+    case Op::add3:
+    case Op::ldr2:
+    case Op::ldrb2:
+    case Op::ldrh2:
+    case Op::ldrsb:
+    case Op::ldrsh:
+    case Op::str2:
+    case Op::strb2:
+    case Op::strh2:
+    case Op::sub3:
+      d.rd = inst & 0x7;
+      d.rn = (inst >> 3) & 0x7;
+      d.rm = (inst >> 6) & 0x7;
+      break;
 
-#ifndef UNSAFE_OPTIMIZATIONS
-  ++instructions;
-#endif
+    case Op::add1:
+    case Op::sub1:
+      d.rd = inst & 0x7;
+      d.rn = (inst >> 3) & 0x7;
+      d.imm = (inst >> 6) & 0x7;
+      break;
 
-  Op decodedOp;
-#ifndef UNSAFE_OPTIMIZATIONS
-  if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
-    decodedOp = decodedRom[instructionPtr >> 1];
-  else
-    decodedOp = decodeInstructionWord(inst);
-#else
-  decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
-#endif
+    case Op::ldr1:
+    case Op::ldrb1:
+    case Op::ldrh1:
+    case Op::str1:
+    case Op::strb1:
+    case Op::strh1:
+      d.rd = inst & 0x7;
+      d.rn = (inst >> 3) & 0x7;
+      d.imm = (inst >> 6) & 0x1F;
+      break;
+
+    case Op::asr1:
+    case Op::lsl1:
+    case Op::lsr1:
+      d.rd = inst & 0x7;
+      d.rm = (inst >> 3) & 0x7;
+      d.imm = (inst >> 6) & 0x1F;
+      break;
+
+    case Op::add2:
+    case Op::add5:
+    case Op::add6:
+    case Op::ldr3:
+    case Op::ldr4:
+    case Op::mov1:
+    case Op::str3:
+    case Op::sub2:
+      d.rd = (inst >> 8) & 0x7;
+      d.imm = inst & 0xFF;
+      break;
+
+    case Op::cmp1:
+      d.rn = (inst >> 8) & 0x7;
+      d.imm = inst & 0xFF;
+      break;
+
+    case Op::add4:
+    case Op::mov3:
+      d.rd = (inst & 0x7) | ((inst >> 4) & 0x8);
+      d.rm = (inst >> 3) & 0xF;
+      break;
+
+    case Op::cmp3:
+      d.rn = (inst & 0x7) | ((inst >> 4) & 0x8);
+      d.rm = (inst >> 3) & 0xF;
+      break;
+
+    case Op::blx2:
+    case Op::bx:
+      d.rm = (inst >> 3) & 0xF;
+      break;
+
+    case Op::ldmia:
+    case Op::stmia:
+      d.rn = (inst >> 8) & 0x7;
+      break;
+
+    case Op::add7:
+    case Op::sub4:
+      d.imm = inst & 0x7F;
+      break;
+
+    case Op::bkpt:
+    case Op::swi:
+      d.imm = inst & 0xFF;
+      break;
+
+    case Op::b1:
+      d.rn = (inst >> 8) & 0xF;  // condition
+      d.imm = inst & 0xFF;
+      if(d.imm & 0x80)
+        d.imm |= (~0u) << 8;
+      d.imm = (d.imm << 1) + pc + 2;
+      break;
+
+    case Op::b2:
+      d.imm = inst & 0x7FF;
+      if(d.imm & (1 << 10))
+        d.imm |= (~0u) << 11;
+      d.imm = (d.imm << 1) + pc + 2;
+      break;
+
+    case Op::blx1:
+      d.imm = inst & ((1 << 11) - 1);
+      if((inst & 0x1800) == 0x1000) //H=b10
+      {
+        if(d.imm & 1<<10) d.imm |= (~((1 << 11) - 1)); //sign extend
+        d.imm = (d.imm << 12) + pc;
+      }
+      else
+        d.imm <<= 1;
+      break;
+
+    default:
+      break;
+  }
+
+  // The cycles of loads and stores; refilling the pipeline after writing
+  // to the PC, and the extra cycles of MUL are added when running these
+  uInt32 registers = 0;
+  switch(d.op)
+  {
+    case Op::ldr1:
+    case Op::ldr2:
+    case Op::ldr3:
+    case Op::ldr4:
+    case Op::ldrb1:
+    case Op::ldrb2:
+    case Op::ldrh1:
+    case Op::ldrh2:
+    case Op::ldrsb:
+    case Op::ldrsh:
+      d.blockCycles = 3;  // 1S + 1N + 1I
+      break;
+
+    case Op::str1:
+    case Op::str2:
+    case Op::str3:
+    case Op::strb1:
+    case Op::strb2:
+    case Op::strh1:
+    case Op::strh2:
+      d.blockCycles = 2;  // 2N
+      break;
+
+    case Op::ldmia:
+    case Op::pop:
+      for(uInt32 list = inst & (d.op == Op::pop ? 0x1FF : 0xFF); list; list >>= 1)
+        registers += list & 1;
+      d.blockCycles = registers + 2;  // nS + 1N + 1I
+      break;
+
+    case Op::stmia:
+    case Op::push:
+      for(uInt32 list = inst & (d.op == Op::push ? 0x1FF : 0xFF); list; list >>= 1)
+        registers += list & 1;
+      d.blockCycles = registers + 1;  // (n-1)S + 2N
+      break;
+
+    default:
+      break;
+  }
+
+  return d;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Thumbulator::endsBlock(const DecodedInstruction& instruction)
+{
+  switch(instruction.op)
+  {
+    // Branches, and the instructions that leave the ARM code
+    case Op::b1:
+    case Op::b2:
+    case Op::blx1:
+    case Op::blx2:
+    case Op::bx:
+    case Op::bkpt:
+    case Op::cps:
+    case Op::setend:
+    case Op::swi:
+    case Op::invalid:
+      return true;
 
-  switch (decodedOp) {
+    // Writes to the PC
+    case Op::add4:
+    case Op::mov3:
+      return instruction.rd == 15;
+
+    case Op::pop:
+      return instruction.inst & 0x100;
+
+    default:
+      return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::execute(const DecodedInstruction& d)
+{
+  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
+
+  inst = d.inst;
+
+  pc = (reg_norm[15] & ~1u) + 2;
+  reg_norm[15] = pc;
+  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
+
+  switch (d.op) {
     //ADC
     case Op::adc: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -848,9 +1198,9 @@ int Thumbulator::execute()
 
     //ADD(1) small immediate two registers
     case Op::add1: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rb = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       if(rb)
       {
         DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
@@ -875,8 +1225,8 @@ int Thumbulator::execute()
 
     //ADD(2) big immediate one register
     case Op::add2: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
+      rb = d.imm;
+      rd = d.rd;
       DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
       ra = read_register(rd);
       rc = ra + rb;
@@ -890,9 +1240,9 @@ int Thumbulator::execute()
 
     //ADD(3) three registers
     case Op::add3: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -911,9 +1261,8 @@ int Thumbulator::execute()
       {
         //UNPREDICTABLE
       }
-      rd  = (inst >> 0) & 0x7;
-      rd |= (inst >> 4) & 0x8;
-      rm  = (inst >> 3) & 0xF;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -934,8 +1283,8 @@ int Thumbulator::execute()
 
     //ADD(5) rd = pc plus immediate
     case Op::add5: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
+      rb = d.imm;
+      rd = d.rd;
       rb <<= 2;
       DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(15);
@@ -946,8 +1295,8 @@ int Thumbulator::execute()
 
     //ADD(6) rd = sp plus immediate
     case Op::add6: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x7;
+      rb = d.imm;
+      rd = d.rd;
       rb <<= 2;
       DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(13);
@@ -958,7 +1307,7 @@ int Thumbulator::execute()
 
     //ADD(7) sp plus immediate
     case Op::add7: {
-      rb = (inst >> 0) & 0x7F;
+      rb = d.imm;
       rb <<= 2;
       DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(13);
@@ -969,8 +1318,8 @@ int Thumbulator::execute()
 
     //AND
     case Op::and_: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -983,9 +1332,9 @@ int Thumbulator::execute()
 
     //ASR(1) two register immediate
     case Op::asr1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rm = d.rm;
+      rb = d.imm;
       DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
       rc = read_register(rm);
       if(rb == 0)
@@ -1017,8 +1366,8 @@ int Thumbulator::execute()
 
     //ASR(2) two register
     case Op::asr2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
+      rd = d.rd;
+      rs = d.rm;
       DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
       rc = read_register(rd);
       rb = read_register(rs);
@@ -1057,13 +1406,8 @@ int Thumbulator::execute()
 
     //B(1) conditional branch
     case Op::b1: {
-      rb = (inst >> 0) & 0xFF;
-      if(rb & 0x80)
-        rb |= (~0u) << 8;
-      op=(inst >> 8) & 0xF;
-      rb <<= 1;
-      rb += pc;
-      rb += 2;
+      rb = d.imm;
+      op = d.rn;
       switch(op)
       {
         case 0x0: //b eq  z set
@@ -1172,12 +1516,7 @@ int Thumbulator::execute()
 
     //B(2) unconditional branch
     case Op::b2: {
-      rb = (inst >> 0) & 0x7FF;
-      if(rb & (1 << 10))
-        rb |= (~0u) << 11;
-      rb <<= 1;
-      rb += pc;
-      rb += 2;
+      rb = d.imm;
       DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
       write_register(15, rb);
       return 0;
@@ -1185,8 +1524,8 @@ int Thumbulator::execute()
 
     //BIC
     case Op::bic: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -1200,7 +1539,7 @@ int Thumbulator::execute()
 #ifndef UNSAFE_OPTIMIZATIONS
     //BKPT
     case Op::bkpt: {
-      rb = (inst >> 0) & 0xFF;
+      rb = d.imm;
       statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
       return 1;
     }
@@ -1211,18 +1550,14 @@ int Thumbulator::execute()
       if((inst & 0x1800) == 0x1000) //H=b10
       {
         DO_DISS(statusMsg << endl);
-        rb = inst & ((1 << 11) - 1);
-        if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
-        rb <<= 12;
-        rb += pc;
-        write_register(14, rb);
+        write_register(14, d.imm);
         return 0;
       }
       else if((inst & 0x1800) == 0x1800) //H=b11
       {
         //branch to thumb
         rb = read_register(14);
-        rb += (inst & ((1 << 11) - 1)) << 1;
+        rb += d.imm;
         rb += 2;
         DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
         write_register(14, (pc-2) | 1);
@@ -1234,7 +1569,7 @@ int Thumbulator::execute()
         //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
         // fxq: this should exit the code without having to detect it
         rb = read_register(14);
-        rb += (inst & ((1 << 11) - 1)) << 1;
+        rb += d.imm;
         rb &= 0xFFFFFFFC;
         rb += 2;
         DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
@@ -1248,7 +1583,7 @@ int Thumbulator::execute()
 
     //BLX(2)
     case Op::blx2: {
-      rm = (inst >> 3) & 0xF;
+      rm = d.rm;
       DO_DISS(statusMsg << "blx r" << dec << rm << endl);
       rc = read_register(rm);
       //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
@@ -1270,7 +1605,7 @@ int Thumbulator::execute()
 
     //BX
     case Op::bx: {
-      rm = (inst >> 3) & 0xF;
+      rm = d.rm;
       DO_DISS(statusMsg << "bx r" << dec << rm << endl);
       rc = read_register(rm);
       rc += 2;
@@ -1496,8 +1831,8 @@ int Thumbulator::execute()
 
     //CMN
     case Op::cmn: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -1511,8 +1846,8 @@ int Thumbulator::execute()
 
     //CMP(1) compare immediate
     case Op::cmp1: {
-      rb = (inst >> 0) & 0xFF;
-      rn = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rn = d.rn;
       DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
       ra = read_register(rn);
       rc = ra - rb;
@@ -1526,8 +1861,8 @@ int Thumbulator::execute()
 
     //CMP(2) compare register
     case Op::cmp2: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -1546,13 +1881,12 @@ int Thumbulator::execute()
       {
         //UNPREDICTABLE
       }
-      rn = (inst >> 0) & 0x7;
-      rn |= (inst >> 4) & 0x8;
+      rn = d.rn;
       if(rn == 0xF)
       {
         //UNPREDICTABLE
       }
-      rm = (inst >> 3) & 0xF;
+      rm = d.rm;
       DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -1576,8 +1910,8 @@ int Thumbulator::execute()
     case Op::cpy: {
       //same as mov except you can use both low registers
       //going to let mov handle high registers
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
       rc = read_register(rm);
       write_register(rd, rc);
@@ -1586,8 +1920,8 @@ int Thumbulator::execute()
 
     //EOR
     case Op::eor: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -1600,7 +1934,7 @@ int Thumbulator::execute()
 
     //LDMIA
     case Op::ldmia: {
-      rn = (inst >> 8) & 0x7;
+      rn = d.rn;
     #if defined(THUMB_DISS)
       statusMsg << "ldmia r" << dec << rn << "!,{";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -1632,9 +1966,9 @@ int Thumbulator::execute()
 
     //LDR(1) two register immediate
     case Op::ldr1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       rb <<= 2;
       DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(rn) + rb;
@@ -1645,9 +1979,9 @@ int Thumbulator::execute()
 
     //LDR(2) three register
     case Op::ldr2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read32(rb);
@@ -1657,8 +1991,8 @@ int Thumbulator::execute()
 
     //LDR(3)
     case Op::ldr3: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rd = d.rd;
       rb <<= 2;
       DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
       ra = read_register(15);
@@ -1672,8 +2006,8 @@ int Thumbulator::execute()
 
     //LDR(4)
     case Op::ldr4: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rd = d.rd;
       rb <<= 2;
       DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
       ra = read_register(13);
@@ -1686,9 +2020,9 @@ int Thumbulator::execute()
 
     //LDRB(1)
     case Op::ldrb1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(rn) + rb;
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -1709,9 +2043,9 @@ int Thumbulator::execute()
 
     //LDRB(2)
     case Op::ldrb2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -1729,9 +2063,9 @@ int Thumbulator::execute()
 
     //LDRH(1)
     case Op::ldrh1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       rb <<= 1;
       DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(rn) + rb;
@@ -1742,9 +2076,9 @@ int Thumbulator::execute()
 
     //LDRH(2)
     case Op::ldrh2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read16(rb);
@@ -1754,9 +2088,9 @@ int Thumbulator::execute()
 
     //LDRSB
     case Op::ldrsb: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -1777,9 +2111,9 @@ int Thumbulator::execute()
 
     //LDRSH
     case Op::ldrsh: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read16(rb);
@@ -1792,9 +2126,9 @@ int Thumbulator::execute()
 
     //LSL(1)
     case Op::lsl1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rm = d.rm;
+      rb = d.imm;
       DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
       rc = read_register(rm);
       if(rb == 0)
@@ -1817,8 +2151,8 @@ int Thumbulator::execute()
 
     //LSL(2) two register
     case Op::lsl2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
+      rd = d.rd;
+      rs = d.rm;
       DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
       rc = read_register(rd);
       rb = read_register(rs);
@@ -1849,9 +2183,9 @@ int Thumbulator::execute()
 
     //LSR(1) two register immediate
     case Op::lsr1: {
-      rd = (inst >> 0) & 0x07;
-      rm = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rm = d.rm;
+      rb = d.imm;
       DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
       rc = read_register(rm);
       if(rb == 0)
@@ -1872,8 +2206,8 @@ int Thumbulator::execute()
 
     //LSR(2) two register
     case Op::lsr2: {
-      rd = (inst >> 0) & 0x07;
-      rs = (inst >> 3) & 0x07;
+      rd = d.rd;
+      rs = d.rm;
       DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
       rc = read_register(rd);
       rb = read_register(rs);
@@ -1904,8 +2238,8 @@ int Thumbulator::execute()
 
     //MOV(1) immediate
     case Op::mov1: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rd = d.rd;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
       write_register(rd, rb);
       do_nflag(rb);
@@ -1915,8 +2249,8 @@ int Thumbulator::execute()
 
     //MOV(2) two low registers
     case Op::mov2: {
-      rd = (inst >> 0) & 7;
-      rn = (inst >> 3) & 7;
+      rd = d.rd;
+      rn = d.rn;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
       rc = read_register(rn);
       //fprintf(stderr,"0x%08X\n",rc);
@@ -1930,9 +2264,8 @@ int Thumbulator::execute()
 
     //MOV(3)
     case Op::mov3: {
-      rd  = (inst >> 0) & 0x7;
-      rd |= (inst >> 4) & 0x8;
-      rm  = (inst >> 3) & 0xF;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
       rc = read_register(rm);
       if((rd == 14) && (rm == 15))
@@ -1951,8 +2284,8 @@ int Thumbulator::execute()
 
     //MUL
     case Op::mul: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -1960,13 +2293,16 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
+      // 1S + mI, with m depending on the significant bytes of the multiplier
+      rs = (ra & 0x80000000) ? ~ra : ra;
+      cycleCount += (rs > 0xFF) + (rs > 0xFFFF) + (rs > 0xFFFFFF) + 1;
       return 0;
     }
 
     //MVN
     case Op::mvn: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = (~ra);
@@ -1978,8 +2314,8 @@ int Thumbulator::execute()
 
     //NEG
     case Op::neg: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = 0 - ra;
@@ -1993,8 +2329,8 @@ int Thumbulator::execute()
 
     //ORR
     case Op::orr: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -2103,8 +2439,8 @@ int Thumbulator::execute()
 
     //REV
     case Op::rev: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
       DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
       ra = read_register(rn);
       rc  = ((ra >>  0) & 0xFF) << 24;
@@ -2117,8 +2453,8 @@ int Thumbulator::execute()
 
     //REV16
     case Op::rev16: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
       DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
       ra = read_register(rn);
       rc  = ((ra >>  0) & 0xFF) <<  8;
@@ -2131,8 +2467,8 @@ int Thumbulator::execute()
 
     //REVSH
     case Op::revsh: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
       DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
       ra = read_register(rn);
       rc  = ((ra >> 0) & 0xFF) << 8;
@@ -2145,8 +2481,8 @@ int Thumbulator::execute()
 
     //ROR
     case Op::ror: {
-      rd = (inst >> 0) & 0x7;
-      rs = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rs = d.rm;
       DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
       rc = read_register(rd);
       ra = read_register(rs);
@@ -2177,8 +2513,8 @@ int Thumbulator::execute()
 
     //SBC
     case Op::sbc: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rd);
       rb = read_register(rm);
@@ -2210,7 +2546,7 @@ int Thumbulator::execute()
 
     //STMIA
     case Op::stmia: {
-      rn = (inst >> 8) & 0x7;
+      rn = d.rn;
     #if defined(THUMB_DISS)
       statusMsg << "stmia r" << dec << rn << "!,{";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -2240,9 +2576,9 @@ int Thumbulator::execute()
 
     //STR(1)
     case Op::str1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       rb <<= 2;
       DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(rn) + rb;
@@ -2253,9 +2589,9 @@ int Thumbulator::execute()
 
     //STR(2)
     case Op::str2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read_register(rd);
@@ -2265,8 +2601,8 @@ int Thumbulator::execute()
 
     //STR(3)
     case Op::str3: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rd = d.rd;
       rb <<= 2;
       DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(13) + rb;
@@ -2278,9 +2614,9 @@ int Thumbulator::execute()
 
     //STRB(1)
     case Op::strb1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
       rb = read_register(rn) + rb;
       rc = read_register(rd);
@@ -2305,9 +2641,9 @@ int Thumbulator::execute()
 
     //STRB(2)
     case Op::strb2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read_register(rd);
@@ -2332,9 +2668,9 @@ int Thumbulator::execute()
 
     //STRH(1)
     case Op::strh1: {
-      rd = (inst >> 0) & 0x07;
-      rn = (inst >> 3) & 0x07;
-      rb = (inst >> 6) & 0x1F;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       rb <<= 1;
       DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
       rb = read_register(rn) + rb;
@@ -2345,9 +2681,9 @@ int Thumbulator::execute()
 
     //STRH(2)
     case Op::strh2: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
       rb = read_register(rn) + read_register(rm);
       rc = read_register(rd);
@@ -2357,9 +2693,9 @@ int Thumbulator::execute()
 
     //SUB(1)
     case Op::sub1: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rb = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rb = d.imm;
       DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
       ra = read_register(rn);
       rc = ra - rb;
@@ -2373,8 +2709,8 @@ int Thumbulator::execute()
 
     //SUB(2)
     case Op::sub2: {
-      rb = (inst >> 0) & 0xFF;
-      rd = (inst >> 8) & 0x07;
+      rb = d.imm;
+      rd = d.rd;
       DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
       ra = read_register(rd);
       rc = ra - rb;
@@ -2388,9 +2724,9 @@ int Thumbulator::execute()
 
     //SUB(3)
     case Op::sub3: {
-      rd = (inst >> 0) & 0x7;
-      rn = (inst >> 3) & 0x7;
-      rm = (inst >> 6) & 0x7;
+      rd = d.rd;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -2405,7 +2741,7 @@ int Thumbulator::execute()
 
     //SUB(4)
     case Op::sub4: {
-      rb = inst & 0x7F;
+      rb = d.imm;
       rb <<= 2;
       DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(13);
@@ -2416,7 +2752,7 @@ int Thumbulator::execute()
 
     //SWI
     case Op::swi: {
-      rb = inst & 0xFF;
+      rb = d.imm;
       DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
 
       if((inst & 0xFF) == 0xCC)
@@ -2435,8 +2771,8 @@ int Thumbulator::execute()
 
     //SXTB
     case Op::sxtb: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFF;
@@ -2448,8 +2784,8 @@ int Thumbulator::execute()
 
     //SXTH
     case Op::sxth: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFFFF;
@@ -2461,8 +2797,8 @@ int Thumbulator::execute()
 
     //TST
     case Op::tst: {
-      rn = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rn = d.rn;
+      rm = d.rm;
       DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
       ra = read_register(rn);
       rb = read_register(rm);
@@ -2474,8 +2810,8 @@ int Thumbulator::execute()
 
     //UXTB
     case Op::uxtb: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFF;
@@ -2485,8 +2821,8 @@ int Thumbulator::execute()
 
     //UXTH
     case Op::uxth: {
-      rd = (inst >> 0) & 0x7;
-      rm = (inst >> 3) & 0x7;
+      rd = d.rd;
+      rm = d.rm;
       DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFFFF;
@@ -2514,6 +2850,7 @@ int Thumbulator::reset()
 {
   std::fill(reg_norm, reg_norm+12, 0);
   reg_norm[13] = 0x40001FB4;
+  cycleCount = 0;
 
   switch(configuration)
   {
@@ -97,6 +97,21 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      Get the number of ARM cycles the last call to run() took, and the
+      number of cycles taken by all calls so far.
+
+      These are estimated with the instruction timings of the ARM7TDMI core,
+      plus the wait states of the flash memory (as configured by the driver
+      in MAMCR).  Flash is assumed to be accessed with a MAMTIM of 4, as
+      needed at 70 MHz.  With the MAM disabled every access to flash waits
+      for it.  When partially enabled, only data reads and the first fetch
+      after a branch do.  When fully enabled, only the fetches after a
+      branch do.
+    */
+    uInt32 cycles() const { return cycleCount; }
+    uInt64 totalCycles() const { return totalCycleCount; }
+
   private:
 
     enum class Op : uInt8 {
@@ -149,6 +164,22 @@ class Thumbulator
       uxth
     };
 
+    // An instruction word predecoded into its class and its operand fields;
+    // 'rm' also holds the 'rs' register where an instruction uses that, and
+    // for B(1), B(2) and the first half of BL 'imm' is the absolute target.
+    // 'blockSize' is the number of instructions in the basic block starting
+    // here, up to and including the next one that may change the flow, and
+    // 'blockCycles' the ARM cycles these take (without wait states and
+    // refilling the pipeline after a branch, which are added when run).
+    struct DecodedInstruction {
+      Op op;
+      uInt8 rd, rm, rn;
+      uInt16 inst;
+      uInt16 blockSize;
+      uInt32 imm;
+      uInt32 blockCycles;
+    };
+
   private:
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
@@ -163,6 +194,8 @@ class Thumbulator
     void updateTimer(uInt32 cycles);
 
     static Op decodeInstructionWord(uint16_t inst);
+    static DecodedInstruction decodeInstruction(uInt16 inst, uInt32 addr);
+    static bool endsBlock(const DecodedInstruction& instruction);
 
     void do_zflag(uInt32 x);
     void do_nflag(uInt32 x);
@@ -181,13 +214,13 @@ class Thumbulator
     void dump_counters();
     void dump_regs();
 #endif
-    int execute();
+    int execute(const DecodedInstruction& d);
     int reset();
 
   private:
     const uInt16* rom;
     uInt16 romSize;
-    const unique_ptr<Op[]> decodedRom;
+    const unique_ptr<DecodedInstruction[]> decodedRom;
     uInt16* ram;
 
     uInt32 reg_norm[16]; // normal execution mode, do not have a thread mode
@@ -200,6 +233,8 @@ class Thumbulator
 #ifndef NO_THUMB_STATS
     uInt64 fetches, reads, writes;
 #endif
+    uInt32 cycleCount;
+    uInt64 totalCycleCount;
 
     // For emulation of LPC2103's timer 1, used for NTSC/PAL/SECAM detection.
     // Register names from documentation:
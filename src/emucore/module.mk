@@ -53,6 +53,8 @@ MODULE_OBJS := \
 	src/emucore/Console.o \
 	src/emucore/Control.o \
 	src/emucore/ControllerDetector.o \
+	src/emucore/DetectionCache.o \
+	src/emucore/DisplayDetector.o \
 	src/emucore/DispatchResult.o \
 	src/emucore/Driving.o \
 	src/emucore/EventHandler.o \
@@ -83,6 +83,30 @@ void Audio::tick()
   if (++myCounter == 228) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::tick(uInt32 clocks)
+{
+  while (clocks > 0) {
+    // Distance to the next counter value handled by tick()
+    uInt32 skip;
+    if (myCounter <= 9)         skip = 9 - myCounter;
+    else if (myCounter <= 37)   skip = 37 - myCounter;
+    else if (myCounter <= 81)   skip = 81 - myCounter;
+    else if (myCounter <= 149)  skip = 149 - myCounter;
+    else                        skip = 228 + 9 - myCounter;
+
+    if (skip >= clocks) {
+      myCounter = (myCounter + clocks) % 228;
+      return;
+    }
+
+    myCounter = (myCounter + skip) % 228;
+    clocks -= skip + 1;
+
+    tick();
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Audio::phase1()
 {
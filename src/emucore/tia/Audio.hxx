@@ -35,6 +35,12 @@ class Audio : public Serializable
 
     void tick();
 
+    /**
+      Advance by the given number of clocks; equivalent to calling tick() that
+      many times, but only stops at the counter values that trigger a phase.
+    */
+    void tick(uInt32 clocks);
+
     AudioChannel& channel0();
 
     AudioChannel& channel1();
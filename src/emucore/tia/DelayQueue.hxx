@@ -43,6 +43,17 @@ class DelayQueue : public Serializable
 
     template<class T> void execute(T executor);
 
+    /**
+      Is there any pending write in the queue?
+    */
+    bool isEmpty() const { return myPending == 0; }
+
+    /**
+      Advance the queue by the given number of clocks without executing anything.
+      Only valid if the queue is empty.
+    */
+    void skip(uInt32 clocks) { myIndex = (myIndex + clocks) % length; }
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -54,6 +65,9 @@ class DelayQueue : public Serializable
     uInt8 myIndex;
     uInt8 myIndices[0xFF];
 
+    // The total number of writes in all members; not serialized, but recalculated on load
+    uInt32 myPending;
+
   private:
     DelayQueue(const DelayQueue&) = delete;
     DelayQueue(DelayQueue&&) = delete;
@@ -68,7 +82,8 @@ class DelayQueue : public Serializable
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 DelayQueue<length, capacity>::DelayQueue()
-  : myIndex(0)
+  : myIndex(0),
+    myPending(0)
 {
   memset(myIndices, 0xFF, 0xFF);
 }
@@ -84,6 +99,8 @@ void DelayQueue<length, capacity>::push(uInt8 address, uInt8 value, uInt8 delay)
 
   if (currentIndex < length)
     myMembers[currentIndex].remove(address);
+  else
+    ++myPending;
 
   uInt8 index = smartmod<length>(myIndex + delay);
   myMembers[index].push(address, value);
@@ -99,6 +116,7 @@ void DelayQueue<length, capacity>::reset()
     myMembers[i].clear();
 
   myIndex = 0;
+  myPending = 0;
   memset(myIndices, 0xFF, 0xFF);
 }
 
@@ -114,6 +132,7 @@ void DelayQueue<length, capacity>::execute(T executor)
     myIndices[currentMember.myEntries[i].address] = 0xFF;
   }
 
+  myPending -= currentMember.mySize;
   currentMember.clear();
 
   myIndex = smartmod<length>(myIndex + 1);
@@ -150,8 +169,11 @@ bool DelayQueue<length, capacity>::load(Serializer& in)
   {
     if (in.getInt() != length) throw runtime_error("delay queue length mismatch");
 
-    for (uInt8 i = 0; i < length; ++i)
+    myPending = 0;
+    for (uInt8 i = 0; i < length; ++i) {
       myMembers[i].load(in);
+      myPending += myMembers[i].mySize;
+    }
 
     myIndex = in.getByte();
     in.getByteArray(myIndices, 0xFF);
@@ -223,40 +223,35 @@ void Playfield::applyColors()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 Playfield::getColor() const
+uInt8 Playfield::getDebugColor(uInt32 x) const
 {
-  if (!myDebugEnabled)
-    return myX < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
+  if (x < TIAConstants::H_PIXEL / 2)
+  {
+    // left side:
+    if(x < 16)
+      return myDebugColor - 2;    // PF0
+    if(x < 48)
+      return myDebugColor;        // PF1
+  }
   else
   {
-    if (myX < TIAConstants::H_PIXEL / 2)
+    // right side:
+    if(!myReflected)
     {
-      // left side:
-      if(myX < 16)
-        return myDebugColor - 2;    // PF0
-      if(myX < 48)
-        return myDebugColor;        // PF1
+      if(x < TIAConstants::H_PIXEL / 2 + 16)
+        return myDebugColor - 2;  // PF0
+      if(x < TIAConstants::H_PIXEL / 2 + 48)
+        return myDebugColor;      // PF1
     }
     else
     {
-      // right side:
-      if(!myReflected)
-      {
-        if(myX < TIAConstants::H_PIXEL / 2 + 16)
-          return myDebugColor - 2;  // PF0
-        if(myX < TIAConstants::H_PIXEL / 2 + 48)
-          return myDebugColor;      // PF1
-      }
-      else
-      {
-        if(myX >= TIAConstants::H_PIXEL - 16)
-          return myDebugColor - 2;  // PF0
-        if(myX >= TIAConstants::H_PIXEL - 48)
-          return myDebugColor;      // PF1
-      }
+      if(x >= TIAConstants::H_PIXEL - 16)
+        return myDebugColor - 2;  // PF0
+      if(x >= TIAConstants::H_PIXEL - 48)
+        return myDebugColor;      // PF1
     }
-    return myDebugColor + 2;        // PF2
   }
+  return myDebugColor + 2;        // PF2
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
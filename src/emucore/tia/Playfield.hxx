@@ -118,7 +118,16 @@ class Playfield : public Serializable
     /**
       Get the current color.
      */
-    uInt8 getColor() const;
+    uInt8 getColor() const { return getColor(myX); }
+
+    /**
+      Get the color at the given position on the scanline.
+     */
+    uInt8 getColor(uInt32 x) const {
+      if (myDebugEnabled) return getDebugColor(x);
+
+      return x < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
+    }
 
     /**
       Serializable methods (see that class for more information).
@@ -160,6 +169,11 @@ class Playfield : public Serializable
      */
     void updatePattern();
 
+    /**
+      Get the debug color (which depends on the PF register) at the given position.
+     */
+    uInt8 getDebugColor(uInt32 x) const;
+
   private:
 
     /**
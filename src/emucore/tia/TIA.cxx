@@ -65,6 +65,52 @@ enum ResxCounter: uInt8 {
 // 70, the G.I. Joe will show an artifact (hole in roof).
 static constexpr uInt8 resxLateHblankThreshold = TIAConstants::H_CYCLES - 3;
 
+// The object that determines the color of a pixel
+enum class PixelSource: uInt8 {
+  background, playfield, ball, player0, missile0, player1, missile1
+};
+
+// Pixel source for each priority mode (indexed by TIA::Priority) and each
+// combination of visible objects (indexed by the TIABit flags P0Bit ... PFBit)
+class PriorityTable {
+  public:
+    PriorityTable()
+    {
+      struct Object { uInt8 bit; PixelSource source; };
+      static constexpr Object pf{TIABit::PFBit, PixelSource::playfield},
+        bl{TIABit::BLBit, PixelSource::ball},
+        p0{TIABit::P0Bit, PixelSource::player0}, m0{TIABit::M0Bit, PixelSource::missile0},
+        p1{TIABit::P1Bit, PixelSource::player1}, m1{TIABit::M1Bit, PixelSource::missile1};
+
+      // Priority from highest to lowest, see TIA::pixelColor
+      static constexpr Object order[3][6] = {
+        { pf, bl, p0, m0, p1, m1 },  // pfp
+        { p0, m0, pf, p1, m1, bl },  // score
+        { p0, m0, p1, m1, pf, bl }   // normal
+      };
+
+      for (uInt32 priority = 0; priority < 3; ++priority)
+        for (uInt32 objects = 0; objects < 64; ++objects) {
+          mySource[priority][objects] = PixelSource::background;
+
+          for (const Object& object: order[priority])
+            if (objects & object.bit) {
+              mySource[priority][objects] = object.source;
+              break;
+            }
+        }
+    }
+
+    PixelSource source(uInt32 priority, uInt32 objects) const {
+      return mySource[priority][objects];
+    }
+
+  private:
+    PixelSource mySource[3][64];
+};
+
+static const PriorityTable priorityTable;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIA::TIA(ConsoleIO& console, ConsoleTimingProvider timingProvider, Settings& settings)
   : myConsole(console),
@@ -88,6 +134,7 @@ TIA::TIA(ConsoleIO& console, ConsoleTimingProvider timingProvider, Settings& set
   myMissile1.setTIA(this);
   myBall.setTIA(this);
 
+  updateCollisionTable();
   reset();
 }
 
@@ -339,6 +386,7 @@ bool TIA::load(Serializer& in)
 
     mySpriteEnabledBits = in.getByte();
     myCollisionsEnabledBits = in.getByte();
+    updateCollisionTable();
 
     myColorHBlank = in.getByte();
 
@@ -1001,6 +1049,7 @@ bool TIA::toggleCollision(TIABit b, uInt8 mode)
   myPlayer1.toggleCollisions(myCollisionsEnabledBits & TIABit::P1Bit);
   myBall.toggleCollisions(myCollisionsEnabledBits & TIABit::BLBit);
   myPlayfield.toggleCollisions(myCollisionsEnabledBits & TIABit::PFBit);
+  updateCollisionTable();
 
   return mask;
 }
@@ -1262,6 +1311,14 @@ void TIA::cycle(uInt32 colorClocks)
 {
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
+    const uInt32 spanClocks = spanLength(colorClocks - i);
+    if (spanClocks > 1) {
+      cycleSpan(spanClocks);
+      i += spanClocks - 1;
+
+      continue;
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
@@ -1291,6 +1348,53 @@ void TIA::cycle(uInt32 colorClocks)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::spanLength(uInt32 maxClocks) const
+{
+  if (!myDelayQueue.isEmpty()) return 0;
+
+  // The last clock of the line is left to the regular path, which calls nextLine()
+  const uInt32 clocks = std::min<uInt32>(maxClocks, TIAConstants::H_CLOCKS - 1 - myHctr);
+
+  // Nothing but the counters advance while the line cache is active
+  if (myLinesSinceChange >= 2) return clocks;
+
+  if (myMovementInProgress) return 0;
+
+  if (myHstate == HState::frame) return clocks;
+
+  // During hblank, nothing happens between the first clock and the end of hblank
+  return (myHctr > 0 && myHctr < TIAConstants::H_BLANK_CLOCKS - 1) ?
+    std::min<uInt32>(clocks, TIAConstants::H_BLANK_CLOCKS - 1 - myHctr) : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::cycleSpan(uInt32 colorClocks)
+{
+  myDelayQueue.skip(colorClocks);
+
+  const bool isTicking = myLinesSinceChange < 2;
+
+  if (isTicking) {
+    if (myHstate == HState::frame)
+      tickHframeSpan(colorClocks);
+    else if (myCollisionUpdateScheduled && !myFrameManager->vblank())
+      updateCollision();
+  }
+
+  // Leave the collision flags as the last clock on the regular path would
+  myCollisionUpdateRequired = isTicking && myHstate == HState::frame;
+  myCollisionUpdateScheduled = false;
+
+  myHctr += colorClocks;
+
+  #ifdef SOUND_SUPPORT
+    myAudio.tick(colorClocks);
+  #endif
+
+  myTimestamp += colorClocks;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::tickMovement()
 {
@@ -1358,6 +1462,83 @@ void TIA::tickHframe()
     renderPixel(x, y);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::tickHframeSpan(uInt32 colorClocks)
+{
+  const uInt32 x0 = myHctr - TIAConstants::H_BLANK_CLOCKS - myHctrDelta;
+  const uInt32 hctr0 = myHctr;
+
+  // The objects do not interact during a span, so each one is clocked through the
+  // whole span in turn, recording its collision (visibility) state for each clock
+  uInt32 playfield[TIAConstants::H_CLOCKS], ball[TIAConstants::H_CLOCKS],
+         player0[TIAConstants::H_CLOCKS], player1[TIAConstants::H_CLOCKS],
+         missile0[TIAConstants::H_CLOCKS], missile1[TIAConstants::H_CLOCKS];
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myPlayfield.tick(x0 + i);
+    playfield[i] = myPlayfield.collision;
+  }
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myMissile0.tick(hctr0 + i);
+    missile0[i] = myMissile0.collision;
+  }
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myMissile1.tick(hctr0 + i);
+    missile1[i] = myMissile1.collision;
+  }
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myPlayer0.tick();
+    player0[i] = myPlayer0.collision;
+  }
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myPlayer1.tick();
+    player1[i] = myPlayer1.collision;
+  }
+
+  for (uInt32 i = 0; i < colorClocks; ++i) {
+    myBall.tick();
+    ball[i] = myBall.collision;
+  }
+
+  uInt8 objects[TIAConstants::H_CLOCKS];
+  for (uInt32 i = 0; i < colorClocks; ++i)
+    objects[i] = visibleObjects(playfield[i], ball[i], player0[i],
+                                missile0[i], player1[i], missile1[i]);
+
+  const bool vblank = myFrameManager->vblank();
+
+  if (myFrameManager->isRendering()) {
+    uInt8* buffer = myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL;
+
+    // Object colors don't change during a span, only the playfield color
+    // depends on the position
+    const uInt8 colors[] = {
+      myBackground.getColor(), 0, myBall.getColor(), myPlayer0.getColor(),
+      myMissile0.getColor(), myPlayer1.getColor(), myMissile1.getColor()
+    };
+    const uInt32 priority = uInt32(myPriority);
+
+    for (uInt32 i = 0; i < colorClocks; ++i) {
+      const uInt32 x = x0 + i;
+
+      if (x < TIAConstants::H_PIXEL) {
+        const PixelSource source = priorityTable.source(priority, objects[i]);
+
+        buffer[x] = vblank ? 0 : source == PixelSource::playfield ?
+          myPlayfield.getColor(x) : colors[uInt8(source)];
+      }
+    }
+  }
+
+  if (!vblank)
+    for (uInt32 i = 0; i < colorClocks; ++i)
+      myCollisionMask |= myCollisionTable[objects[i]];
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyRsync()
 {
@@ -1418,14 +1599,41 @@ void TIA::scheduleCollisionUpdate()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateCollision()
 {
-  myCollisionMask |= (
-    myPlayer0.collision &
-    myPlayer1.collision &
-    myMissile0.collision &
-    myMissile1.collision &
-    myBall.collision &
-    myPlayfield.collision
-  );
+  myCollisionMask |= myCollisionTable[
+    visibleObjects(myPlayfield.collision, myBall.collision, myPlayer0.collision,
+                   myMissile0.collision, myPlayer1.collision, myMissile1.collision)
+  ];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateCollisionTable()
+{
+  struct Object { uInt8 bit; uInt32 mask; };
+  static constexpr Object objects[] = {
+    { TIABit::P0Bit, CollisionMask::player0 },
+    { TIABit::M0Bit, CollisionMask::missile0 },
+    { TIABit::P1Bit, CollisionMask::player1 },
+    { TIABit::M1Bit, CollisionMask::missile1 },
+    { TIABit::BLBit, CollisionMask::ball },
+    { TIABit::PFBit, CollisionMask::playfield }
+  };
+
+  // Combine the collision words that the objects would produce for each
+  // combination of visible objects (see Player::toggleCollisions etc.)
+  for (uInt32 visible = 0; visible < 64; ++visible) {
+    uInt32 collision = 0xFFFF;
+
+    for (const Object& object: objects) {
+      const uInt32 disabled = ~object.mask & 0x7FFF;
+
+      if (!(visible & object.bit))
+        collision &= disabled;
+      else if (!(myCollisionsEnabledBits & object.bit))
+        collision &= 0x8000 | disabled;
+    }
+
+    myCollisionTable[visible] = collision;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1433,57 +1641,52 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
 {
   if (x >= TIAConstants::H_PIXEL) return;
 
-  uInt8 color = 0;
+  myBackBuffer[y * TIAConstants::H_PIXEL + x] = myFrameManager->vblank() ? 0 :
+    pixelColor(x, visibleObjects(myPlayfield.collision, myBall.collision, myPlayer0.collision,
+                                 myMissile0.collision, myPlayer1.collision, myMissile1.collision));
+}
 
-  if (!myFrameManager->vblank())
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt8 TIA::pixelColor(uInt32 x, uInt32 objects) const
+{
+  // Priority from highest to lowest:
+  //   CTRLPF D2=1, D1=ignored (playfield priority, ScoreBit isn't used):
+  //     BL/PF => P0/M0 => P1/M1 => BK
+  //   CTRLPF D2=0, D1=1 (score mode):
+  //     Formally we have
+  //       PF/P0/M0 => P1/M1 => BL => BK
+  //     for the first half and
+  //       P0/M0 => PF/P1/M1 => BL => BK
+  //     for the second half. However, the first ordering is equivalent
+  //     to the second (PF has the same color as P0/M0), so we just use the latter.
+  //   CTRLPF D2=0, D1=0:
+  //     P0/M0 => P1/M1 => BL/PF => BK
+  switch (priorityTable.source(uInt32(myPriority), objects))
   {
-    switch (myPriority)
-    {
-      case Priority::pfp:  // CTRLPF D2=1, D1=ignored
-        // Playfield has priority so ScoreBit isn't used
-        // Priority from highest to lowest:
-        //   BL/PF => P0/M0 => P1/M1 => BK
-        if (myPlayfield.isOn())       color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else if (myPlayer0.isOn())    color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else                          color = myBackground.getColor();
-        break;
-
-      case Priority::score:  // CTRLPF D2=0, D1=1
-        // Formally we have (priority from highest to lowest)
-        //   PF/P0/M0 => P1/M1 => BL => BK
-        // for the first half and
-        //   P0/M0 => PF/P1/M1 => BL => BK
-        // for the second half. However, the first ordering is equivalent
-        // to the second (PF has the same color as P0/M0), so we can just
-        // write
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
-
-      case Priority::normal:  // CTRLPF D2=0, D1=0
-        // Priority from highest to lowest:
-        //   P0/M0 => P1/M1 => BL/PF => BK
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
-    }
+    case PixelSource::background: return myBackground.getColor();
+    case PixelSource::playfield:  return myPlayfield.getColor(x);
+    case PixelSource::ball:       return myBall.getColor();
+    case PixelSource::player0:    return myPlayer0.getColor();
+    case PixelSource::missile0:   return myMissile0.getColor();
+    case PixelSource::player1:    return myPlayer1.getColor();
+    case PixelSource::missile1:   return myMissile1.getColor();
   }
 
-  myBackBuffer[y * TIAConstants::H_PIXEL + x] = color;
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 TIA::visibleObjects(uInt32 playfield, uInt32 ball, uInt32 player0,
+                                  uInt32 missile0, uInt32 player1, uInt32 missile1)
+{
+  // Bit 15 of the collision mask indicates whether an object is visible
+  return
+    ((player0   >> 15) & TIABit::P0Bit) |
+    ((missile0  >> 14) & TIABit::M0Bit) |
+    ((player1   >> 13) & TIABit::P1Bit) |
+    ((missile1  >> 12) & TIABit::M1Bit) |
+    ((ball      >> 11) & TIABit::BLBit) |
+    ((playfield >> 10) & TIABit::PFBit);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -523,6 +523,15 @@ class TIA : public Device
     */
     bool load(Serializer& in) override;
 
+    /**
+      The number of bytes by which a saved state of the TIA can grow at
+      most, when writes are pending in the delay queue (each pending write
+      is saved with its address and value).
+    */
+    static constexpr uInt32 maxStateGrowth() {
+      return delayQueueLength * delayQueueSize * 2;
+    }
+
     /**
      * Run and forward TIA emulation to the current system clock.
      */
@@ -570,6 +579,19 @@ class TIA : public Device
      */
     void cycle(uInt32 colorClocks);
 
+    /**
+     * Determine how many of the next (at most maxClocks) clocks can be processed
+     * in a single batch by cycleSpan. This is possible as long as no delayed write
+     * is pending, no movement is in progress and the line does not end.
+     */
+    uInt32 spanLength(uInt32 maxClocks) const;
+
+    /**
+     * Execute colorClocks cycles in a single batch; the result is identical to
+     * running them one by one.
+     */
+    void cycleSpan(uInt32 colorClocks);
+
     /**
      * Advance the movement logic by a single clock.
      */
@@ -585,11 +607,24 @@ class TIA : public Device
      */
     void tickHframe();
 
+    /**
+     * Advance several clocks during the visible part of the scanline (no movement
+     * and no writes). The objects are clocked one after the other, and the pixels
+     * and collisions are resolved afterwards.
+     */
+    void tickHframeSpan(uInt32 colorClocks);
+
     /**
      * Update the collision bitfield.
      */
     void updateCollision();
 
+    /**
+     * Recompute the collision bits latched for each combination of visible
+     * objects (called whenever collisions are toggled).
+     */
+    void updateCollisionTable();
+
     /**
      * Execute a RSYNC.
      */
@@ -600,6 +635,19 @@ class TIA : public Device
      */
     void renderPixel(uInt32 x, uInt32 y);
 
+    /**
+     * Determine the color of the pixel at x from the visible objects (TIABit
+     * flags) according to the current priority.
+     */
+    uInt8 pixelColor(uInt32 x, uInt32 objects) const;
+
+    /**
+     * Combine the visibility bits of the objects' collision words into a set
+     * of TIABit flags.
+     */
+    static uInt32 visibleObjects(uInt32 playfield, uInt32 ball, uInt32 player0,
+                                 uInt32 missile0, uInt32 player1, uInt32 missile1);
+
     /**
      * Clear the first 8 pixels of a scanline with black if we are in hblank
      * (called during HMOVE).
@@ -851,6 +899,12 @@ class TIA : public Device
     uInt8 mySpriteEnabledBits;
     uInt8 myCollisionsEnabledBits;
 
+    /**
+     * Collision bits latched for each combination of visible objects (indexed
+     * by the TIABit flags), derived from myCollisionsEnabledBits.
+     */
+    uInt32 myCollisionTable[64];
+
     /**
      * The color used to highlight HMOVE blanks (if enabled).
      */
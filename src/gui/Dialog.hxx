@@ -144,6 +144,9 @@ class Dialog : public GuiObject
     virtual void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
     virtual Event::Type getJoyAxisEvent(int stick, int axis, int value);
 
+    /** Called at regular intervals while the dialog is on top */
+    virtual void tick() { }
+
     Widget* findWidget(int x, int y) const; // Find the widget at pos x,y if any
 
     void addOKCancelBGroup(WidgetArray& wid, const GUI::Font& font,
@@ -49,6 +49,9 @@ void DialogContainer::updateTime(uInt64 time)
   // Check for pending continuous events and send them to the active dialog box
   Dialog* activeDialog = myDialogStack.top();
 
+  // Let the active dialog do any work that was deferred
+  activeDialog->tick();
+
   // Mouse button still pressed
   if(myCurrentMouseDown.b != MouseButton::NONE && myClickRepeatTime < myTime)
   {
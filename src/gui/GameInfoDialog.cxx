@@ -420,7 +420,7 @@ void GameInfoDialog::loadControllerProperties(const Properties& props)
 {
   bool swapPorts = props.get(PropType::Console_SwapPorts) == "YES";
   bool autoDetect = false;
-  ByteBuffer image;
+  MappedData image;
   string md5 = props.get(PropType::Cart_MD5);
   uInt32 size = 0;
   const FilesystemNode& node = FilesystemNode(instance().launcher().selectedRom());
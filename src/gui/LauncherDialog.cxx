@@ -24,7 +24,6 @@
 #include "EditTextWidget.hxx"
 #include "FSNode.hxx"
 #include "GameList.hxx"
-#include "MD5.hxx"
 #include "OptionsDialog.hxx"
 #include "GlobalPropsDialog.hxx"
 #include "StellaSettingsDialog.hxx"
@@ -36,6 +35,8 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndex.hxx"
+#include "RomInfoLoader.hxx"
 #include "RomInfoWidget.hxx"
 #include "Settings.hxx"
 #include "StringListWidget.hxx"
@@ -155,6 +156,7 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
         romWidth < 660 ? instance().frameBuffer().smallFont() :
                          instance().frameBuffer().infoFont(),
         xpos, ypos, romWidth, myList->getHeight());
+    myRomInfoLoader = make_unique<RomInfoLoader>(osystem);
   }
 
   // Add textfield to show current directory
@@ -258,7 +260,7 @@ const string& LauncherDialog::selectedRomMD5()
 
   // Make sure we have a valid md5 for this ROM
   if(myGameList->md5(item) == "")
-    myGameList->setMd5(item, MD5::hash(node));
+    myGameList->setMd5(item, instance().romIndex().md5(node));
 
   return myGameList->md5(item);
 }
@@ -288,19 +290,19 @@ void LauncherDialog::loadConfig()
 
   if(myRomInfoWidget)
   {
-    int item = myList->getSelected();
-    if(item < 0) return;
-    const FilesystemNode node(myGameList->path(item));
-
-    myRomInfoWidget->reloadProperties(node);
+    // The ROMs, snapshots or settings may have changed in the meantime,
+    // so the info is gathered again, in the background
+    myRomInfoLoader->clear();
+    loadRomInfo();
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::updateListing(const string& nameToSelect)
 {
-  // Start with empty list
+  // Start with empty list, and store what was learned about the previous one
   myGameList->clear();
+  instance().romIndex().flush();
   myDir->setText("");
 
   loadDirListing();
@@ -338,7 +340,12 @@ void LauncherDialog::loadDirListing()
 
   FSList files;
   files.reserve(2048);
-  myCurrentNode.getChildren(files, FilesystemNode::ListMode::All);
+  const bool listed =
+      myCurrentNode.getChildren(files, FilesystemNode::ListMode::All);
+
+  // Forget about ROMs which were deleted or renamed since the last listing
+  if(listed)
+    instance().romIndex().prune(myCurrentNode, files);
 
   // Add '[..]' to indicate previous folder
   if(myCurrentNode.hasParent())
@@ -359,7 +366,12 @@ void LauncherDialog::loadDirListing()
     if(domatch && !isDir && !matchPattern(name, myPattern->getText()))
       continue;
 
-    myGameList->appendGame(name, f.getPath(), "", isDir);
+    // The MD5 of already known ROMs is taken from the index
+    RomIndex::Entry entry;
+    if(!isDir && instance().romIndex().lookup(f, entry))
+      myGameList->appendGame(name, f.getPath(), entry.md5, false);
+    else
+      myGameList->appendGame(name, f.getPath(), "", isDir);
   }
 
   // Sort the list by rom name (since that's what we see in the listview)
@@ -373,21 +385,61 @@ void LauncherDialog::loadRomInfo()
   int item = myList->getSelected();
   if(item < 0) return;
 
-  const FilesystemNode node(myGameList->path(item));
-  if(!node.isDirectory() && Bankswitch::isValidRomName(node))
-  {
-    // Make sure we have a valid md5 for this ROM
-    if(myGameList->md5(item) == "")
-      myGameList->setMd5(item, MD5::hash(node));
+  auto isRom = [&](int i) {
+    return i >= 0 && uInt32(i) < myGameList->size() && !myGameList->isDir(i) &&
+           Bankswitch::isValidRomName(myGameList->path(i));
+  };
 
-    // Get the properties for this entry
-    Properties props;
-    instance().propSet().getMD5WithInsert(node, myGameList->md5(item), props);
+  myRomInfoWidget->clearProperties();
+  myPendingRomInfo = "";
 
-    myRomInfoWidget->setProperties(props, node);
+  // The info for the selected ROM is gathered in the background, along with
+  // that of its neighbours, which are likely to be selected next
+  StringList paths;
+  if(isRom(item))
+  {
+    myPendingRomInfo = myGameList->path(item);
+    paths.push_back(myPendingRomInfo);
   }
-  else
-    myRomInfoWidget->clearProperties();
+  for(int offset = 1; offset <= 2; ++offset)
+  {
+    if(isRom(item + offset)) paths.push_back(myGameList->path(item + offset));
+    if(isRom(item - offset)) paths.push_back(myGameList->path(item - offset));
+  }
+  myRomInfoLoader->request(paths);
+
+  // The info may already be available
+  updateRomInfo();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::updateRomInfo()
+{
+  if(myPendingRomInfo == "") return;
+
+  auto info = myRomInfoLoader->get(myPendingRomInfo);
+  if(!info) return;
+
+  // Remember the md5 for this ROM
+  int item = myList->getSelected();
+  if(item >= 0 && myGameList->path(item) == myPendingRomInfo &&
+     myGameList->md5(item) == "")
+    myGameList->setMd5(item, info->md5);
+
+  // Make sure the properties entry exists, like getMD5WithInsert does
+  Properties props;
+  if(!instance().propSet().getMD5(info->md5, props))
+    instance().propSet().insert(info->props, false);
+
+  myRomInfoWidget->setRomInfo(info);
+  myPendingRomInfo = "";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::tick()
+{
+  if(myRomInfoLoader)
+    updateRomInfo();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -637,6 +689,10 @@ void LauncherDialog::startGame()
     }
     else
     {
+      // Don't gather ROM info in the background while the game is running
+      if(myRomInfoLoader)
+        myRomInfoLoader->request(StringList());
+
       const string& result =
         instance().createConsole(romnode, myGameList->md5(item));
       if(result == EmptyString)
@@ -30,6 +30,7 @@ class StellaSettingsDialog;
 class OSystem;
 class Properties;
 class EditTextWidget;
+class RomInfoLoader;
 class RomInfoWidget;
 class StaticTextWidget;
 class StringListWidget;
@@ -91,12 +92,14 @@ class LauncherDialog : public Dialog
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
     void handleJoyDown(int stick, int button) override;
     Event::Type getJoyAxisEvent(int stick, int axis, int value) override;
+    void tick() override;
 
     void loadConfig() override;
     void updateListing(const string& nameToSelect = "");
 
     void loadDirListing();
     void loadRomInfo();
+    void updateRomInfo();
     void handleContextMenu();
     void showOnlyROMs(bool state);
     bool matchPattern(const string& s, const string& pattern) const;
@@ -125,6 +128,11 @@ class LauncherDialog : public Dialog
 
     RomInfoWidget* myRomInfoWidget;
 
+    // Gathers the ROM info in the background, and the path of the ROM
+    // whose info is still to be shown
+    unique_ptr<RomInfoLoader> myRomInfoLoader;
+    string myPendingRomInfo;
+
     int mySelectedItem;
     FilesystemNode myCurrentNode;
     Common::FixedStack<string> myNodeNames;
@@ -15,6 +15,12 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "bspf.hxx"
 #include "Launcher.hxx"
 #include "Bankswitch.hxx"
@@ -26,9 +32,9 @@
 #include "Font.hxx"
 #include "MessageBox.hxx"
 #include "FrameBuffer.hxx"
-#include "MD5.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndex.hxx"
 #include "Settings.hxx"
 #include "RomAuditDialog.hxx"
 
@@ -120,48 +126,114 @@ void RomAuditDialog::auditRoms()
   files.reserve(2048);
   node.getChildren(files, FilesystemNode::ListMode::FilesOnly);
 
+  // Only valid ROM files are audited
+  FSList roms;
+  StringList extensions;
+  roms.reserve(files.size());
+  for(const auto& f: files)
+  {
+    string extension;
+    if(f.isFile() && Bankswitch::isValidRomName(f, extension))
+    {
+      roms.push_back(f);
+      extensions.push_back(extension);
+    }
+  }
+
   // Create a progress dialog box to show the progress of processing
   // the ROMs, since this is usually a time-consuming operation
   ProgressDialog progress(this, instance().frameBuffer().font(),
                           "Auditing ROM files ...");
-  progress.setRange(0, int(files.size()) - 1, 5);
+  progress.setRange(0, int(roms.size()) - 1, 5);
+
+  // Reading and hashing the ROMs and looking up their properties is done by
+  // several workers, so that I/O and hashing overlap; the results are
+  // consumed here (in the order of completion), and only renaming is done
+  // on this thread
+  struct Result {
+    uInt32 idx;
+    string md5, name;
+  };
+  std::deque<Result> results;
+  std::mutex resultMutex;
+  std::condition_variable resultCondition;
+  std::atomic<uInt32> next(0);
+
+  RomIndex& index = instance().romIndex();
+  const PropertiesSet& propSet = instance().propSet();
+  auto work = [&]() {
+    Properties props;
+    for(uInt32 idx = next++; idx < roms.size(); idx = next++)
+    {
+      // Calculate the MD5 (unless already known) so we can get the rest
+      // of the info from the PropertiesSet (stella.pro)
+      Result result{idx, index.md5(roms[idx]), EmptyString};
+      if(propSet.getMD5(result.md5, props))
+      {
+        result.name = props.get(PropType::Cart_Name);
+        index.update(roms[idx], { result.md5, "", result.name });
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        results.push_back(result);
+      }
+      resultCondition.notify_one();
+    }
+  };
+
+  vector<std::thread> workers;
+  uInt32 numWorkers = BSPF::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+  try
+  {
+    for(uInt32 i = 0; i < numWorkers && i < roms.size(); ++i)
+      workers.emplace_back(work);
+  }
+  catch(const std::system_error&)
+  {
+    // Use the workers we got; without any, do all the work right here
+    if(workers.empty())
+      work();
+  }
 
-  // Create a entry for the GameList for each file
-  Properties props;
   int renamed = 0, notfound = 0;
-  for(uInt32 idx = 0; idx < files.size(); ++idx)
+  for(uInt32 done = 0; done < roms.size(); ++done)
   {
-    string extension;
-    if(files[idx].isFile() &&
-       Bankswitch::isValidRomName(files[idx], extension))
+    Result result;
     {
-      bool renameSucceeded = false;
+      std::unique_lock<std::mutex> lock(resultMutex);
+      resultCondition.wait(lock, [&]() { return !results.empty(); });
+      result = results.front();
+      results.pop_front();
+    }
 
-      // Calculate the MD5 so we can get the rest of the info
-      // from the PropertiesSet (stella.pro)
-      const string& md5 = MD5::hash(files[idx]);
-      if(instance().propSet().getMD5(md5, props))
+    bool renameSucceeded = false;
+    FilesystemNode& rom = roms[result.idx];
+
+    // Only rename the file if we found a valid properties entry
+    if(result.name != "" && result.name != rom.getName())
+    {
+      const string& newfile = node.getPath() + result.name + "." +
+                              extensions[result.idx];
+      if(rom.getPath() != newfile && rom.rename(newfile))
       {
-        const string& name = props.get(PropType::Cart_Name);
-
-        // Only rename the file if we found a valid properties entry
-        if(name != "" && name != files[idx].getName())
-        {
-          const string& newfile = node.getPath() + name + "." + extension;
-          if(files[idx].getPath() != newfile && files[idx].rename(newfile))
-            renameSucceeded = true;
-        }
+        index.update(FilesystemNode(newfile), { result.md5, "", result.name });
+        renameSucceeded = true;
       }
-      if(renameSucceeded)
-        ++renamed;
-      else
-        ++notfound;
     }
+    if(renameSucceeded)
+      ++renamed;
+    else
+      ++notfound;
 
     // Update the progress bar, indicating one more ROM has been processed
-    progress.setProgress(idx);
+    progress.setProgress(done);
   }
+  for(auto& worker: workers)
+    worker.join();
+
   progress.close();
+  index.flush();
 
   myResults1->setText(Variant(renamed).toString());
   myResults2->setText(Variant(notfound).toString());
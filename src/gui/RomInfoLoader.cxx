@@ -0,0 +1,279 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+
+#include "OSystem.hxx"
+#include "CartDetector.hxx"
+#include "ControllerDetector.hxx"
+#include "FSNode.hxx"
+#include "MD5.hxx"
+#include "PropsSet.hxx"
+#include "RomIndex.hxx"
+#include "Settings.hxx"
+#include "RomInfoLoader.hxx"
+
+namespace {
+  // The number of ROMs whose information is kept
+  constexpr size_t CACHE_SIZE = 16;
+
+  // Reading ROMs and snapshots is mostly I/O bound, so a few workers suffice
+  constexpr uInt32 MAX_WORKERS = 2;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomInfoLoader::RomInfoLoader(OSystem& osystem)
+  : myOSystem(osystem),
+    myGeneration(0),
+    myQuit(false)
+{
+  uInt32 workers = BSPF::clamp(std::thread::hardware_concurrency(), 1u, MAX_WORKERS);
+
+  for(uInt32 i = 0; i < workers; ++i)
+    myWorkers.emplace_back(&RomInfoLoader::work, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomInfoLoader::~RomInfoLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myWakeupCondition.notify_all();
+
+  for(auto& worker: myWorkers)
+    worker.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::request(const StringList& paths)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    updateContext();
+    myWanted = paths;
+    myPending.clear();
+    for(const auto& path: paths)
+      if(myCacheIndex.find(path) == myCacheIndex.end() &&
+         std::find(myLoading.begin(), myLoading.end(), path) == myLoading.end())
+        myPending.push_back(path);
+  }
+  myWakeupCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<const RomInfoLoader::RomInfo> RomInfoLoader::get(const string& path)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  auto it = myCacheIndex.find(path);
+  if(it == myCacheIndex.end())
+    return nullptr;
+
+  // Mark the entry as the most recently used one
+  myCache.splice(myCache.begin(), myCache, it->second);
+
+  return it->second->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    updateContext();
+    myCache.clear();
+    myCacheIndex.clear();
+    ++myGeneration;
+
+    // Still wanted ROMs are gathered again; those currently being worked on
+    // are requeued by the workers
+    myPending.clear();
+    for(const auto& path: myWanted)
+      if(std::find(myLoading.begin(), myLoading.end(), path) == myLoading.end())
+        myPending.push_back(path);
+  }
+  myWakeupCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::updateContext()
+{
+  myContext.detectControllers = myOSystem.settings().getBool("rominfo");
+#ifdef PNG_SUPPORT
+  myContext.snapshotLoadDir = myOSystem.snapshotLoadDir();
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::loadRom(const OSystem& osystem, const Context& context,
+                            const FilesystemNode& node, RomInfo& info)
+{
+  // The image is mapped only once, for the MD5 and all detection
+  MappedData image;
+  uInt32 size = 0;
+  bool readError = false;
+  try
+  {
+    size = node.map(image);
+  }
+  catch(const runtime_error&)
+  {
+    readError = true;
+  }
+
+  // The MD5 and the bankswitch type are taken from the index if possible
+  RomIndex::Entry entry;
+  bool indexed = size > 0 && osystem.romIndex().lookup(node, entry) &&
+                 entry.type != "";
+  if(indexed)
+  {
+    info.md5 = entry.md5;
+    info.detectedType = entry.type;
+  }
+  else if(size > 0)
+  {
+    info.md5 = MD5::hash(image.get(), size);
+    info.detectedType =
+        Bankswitch::typeToName(CartDetector::autodetectType(image.get(), size));
+  }
+  else
+    info.md5 = info.detectedType = EmptyString;
+
+  // Get the properties for this entry; if there are none, the ROM name is
+  // used (as done by PropertiesSet::getMD5WithInsert)
+  if(!osystem.propSet().getMD5(info.md5, info.props))
+  {
+    info.props.set(PropType::Cart_MD5, info.md5);
+    info.props.set(PropType::Cart_Name, node.getNameWithExt(""));
+  }
+
+  if(!indexed && size > 0)
+    osystem.romIndex().update(node,
+        { info.md5, info.detectedType, info.props.get(PropType::Cart_Name) });
+
+  info.leftController = info.props.get(PropType::Controller_Left);
+  info.rightController = info.props.get(PropType::Controller_Right);
+  if(readError)
+  {
+    // We simply don't show the controllers if the ROM couldn't be read
+    info.leftController = info.rightController = "";
+  }
+  else if(size > 0)
+  {
+    bool swappedPorts = info.props.get(PropType::Console_SwapPorts) == "YES";
+
+    info.leftController = ControllerDetector::detectName(image.get(), size,
+        info.leftController,
+        !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
+        context.detectControllers);
+    info.rightController = ControllerDetector::detectName(image.get(), size,
+        info.rightController,
+        !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
+        context.detectControllers);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::loadSnapshot(const Context& context, RomInfo& info)
+{
+  info.haveSnapshot = false;
+  info.snapshotError = "";
+
+#ifdef PNG_SUPPORT
+  // Get a valid filename representing a snapshot file for this rom
+  const string& filename = context.snapshotLoadDir +
+      info.props.get(PropType::Cart_Name) + ".png";
+
+  try
+  {
+    PNGLibrary::readImage(filename, info.snapshot);
+    info.haveSnapshot = true;
+  }
+  catch(const runtime_error& e)
+  {
+    info.snapshotError = e.what();
+  }
+#else
+  info.snapshotError = "PNG image loading not supported";
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoLoader::work()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myWakeupCondition.wait(lock, [this]() { return myQuit || !myPending.empty(); });
+    if(myQuit)
+      return;
+
+    const string path = myPending.front();
+    const uInt32 generation = myGeneration;
+    const Context context = myContext;
+    myPending.pop_front();
+    myLoading.push_back(path);
+
+    // A request is dropped as soon as it's no longer wanted
+    auto cancelled = [&]() {
+      return myQuit || generation != myGeneration || !isWanted(path);
+    };
+
+    auto info = make_shared<RomInfo>();
+    lock.unlock();
+    loadRom(myOSystem, context, FilesystemNode(path), *info);
+    lock.lock();
+
+    if(!cancelled())
+    {
+      lock.unlock();
+      loadSnapshot(context, *info);
+      lock.lock();
+    }
+
+    myLoading.erase(std::find(myLoading.begin(), myLoading.end(), path));
+    if(myQuit)
+      return;
+    if(!isWanted(path))
+      continue;
+    if(generation != myGeneration)
+    {
+      // The information may be outdated, so gather it again
+      myPending.push_front(path);
+      continue;
+    }
+
+    myCache.emplace_front(path, info);
+    myCacheIndex[path] = myCache.begin();
+    if(myCache.size() > CACHE_SIZE)
+    {
+      myCacheIndex.erase(myCache.back().first);
+      myCache.pop_back();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoLoader::isWanted(const string& path) const
+{
+  return std::find(myWanted.begin(), myWanted.end(), path) != myWanted.end();
+}
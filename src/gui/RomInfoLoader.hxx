@@ -0,0 +1,156 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2019 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INFO_LOADER_HXX
+#define ROM_INFO_LOADER_HXX
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+class FilesystemNode;
+class OSystem;
+
+#include "bspf.hxx"
+#include "Props.hxx"
+#ifdef PNG_SUPPORT
+  #include "PNGLibrary.hxx"
+#endif
+
+/**
+  Prepares the information shown by the launcher for a ROM (MD5,
+  properties, detected controllers and the decoded snapshot) in the
+  background, so that the UI doesn't stall while moving through a list
+  of ROMs, especially on slow (network) filesystems.
+
+  The launcher requests the selected ROM and its neighbours; pending
+  requests which are no longer wanted are cancelled.  The results are
+  kept in a small LRU cache, from which the launcher takes them when
+  they are ready.
+*/
+class RomInfoLoader
+{
+  public:
+    /**
+      Everything the launcher shows about a ROM.
+    */
+    struct RomInfo {
+      string md5;
+      Properties props;
+
+      // The autodetected bankswitch type; empty if the ROM couldn't be read
+      string detectedType;
+
+      // The detected controllers; empty if the ROM couldn't be read
+      string leftController, rightController;
+
+      // The snapshot of the ROM, or the reason why there is none
+    #ifdef PNG_SUPPORT
+      PNGLibrary::Image snapshot;
+    #endif
+      bool haveSnapshot{false};
+      string snapshotError;
+    };
+
+    explicit RomInfoLoader(OSystem& osystem);
+    ~RomInfoLoader();
+
+    /**
+      Request information for the given ROMs, in order of priority.  All
+      previous requests which aren't part of this one are cancelled.
+
+      @param paths  The paths of the ROMs
+    */
+    void request(const StringList& paths);
+
+    /**
+      Get the information for a ROM, if it's ready.
+
+      @param path  The path of the ROM
+      @return  The information, or nullptr if it isn't (yet) available
+    */
+    shared_ptr<const RomInfo> get(const string& path);
+
+    /**
+      Forget all information, since the ROM files, snapshots or settings
+      may have changed.  Wanted ROMs are gathered again.
+    */
+    void clear();
+
+  private:
+    // The settings used to gather the information; the workers must not
+    // access the settings, since they may be changed by the UI thread at
+    // any time, so the values are copied by request() and clear()
+    struct Context {
+      bool detectControllers{false};  // the 'rominfo' setting
+      string snapshotLoadDir;
+    };
+
+    // Copy the current settings; must be called on the UI thread, with
+    // myMutex held
+    void updateContext();
+
+    // Gather the MD5, properties and controllers of a ROM
+    static void loadRom(const OSystem& osystem, const Context& context,
+                        const FilesystemNode& node, RomInfo& info);
+
+    // Decode the snapshot of a ROM whose properties are already known
+    static void loadSnapshot(const Context& context, RomInfo& info);
+
+    // The loop run by each worker thread
+    void work();
+
+    // Answer whether the ROM is still wanted; the caller must hold the lock
+    bool isWanted(const string& path) const;
+
+  private:
+    const OSystem& myOSystem;
+
+    // The ROMs whose information is (still) wanted, in order of priority,
+    // those not started yet, and those currently being worked on
+    StringList myWanted;
+    std::list<string> myPending;
+    StringList myLoading;
+
+    // The most recently used results, and the cache entry for each path
+    using CacheList = std::list<std::pair<string, shared_ptr<const RomInfo>>>;
+    CacheList myCache;
+    std::unordered_map<string, CacheList::iterator> myCacheIndex;
+
+    // Incremented by clear(), so results gathered before are dropped
+    uInt32 myGeneration;
+
+    Context myContext;
+
+    bool myQuit;
+
+    std::mutex myMutex;
+    std::condition_variable myWakeupCondition;
+    vector<std::thread> myWorkers;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomInfoLoader() = delete;
+    RomInfoLoader(const RomInfoLoader&) = delete;
+    RomInfoLoader(RomInfoLoader&&) = delete;
+    RomInfoLoader& operator=(const RomInfoLoader&) = delete;
+    RomInfoLoader& operator=(RomInfoLoader&&) = delete;
+};
+
+#endif
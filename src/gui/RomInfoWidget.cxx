@@ -15,13 +15,13 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include "Bankswitch.hxx"
 #include "EventHandler.hxx"
 #include "FrameBuffer.hxx"
 #include "Dialog.hxx"
 #include "FBSurface.hxx"
 #include "Font.hxx"
 #include "OSystem.hxx"
-#include "ControllerDetector.hxx"
 #include "Props.hxx"
 #include "PNGLibrary.hxx"
 #include "Rect.hxx"
@@ -45,24 +45,18 @@ RomInfoWidget::RomInfoWidget(GuiObject* boss, const GUI::Font& font,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void RomInfoWidget::reloadProperties(const FilesystemNode& node)
-{
-  // The ROM may have changed since we were last in the browser, either
-  // by saving a different image or through a change in video renderer,
-  // so we reload the properties
-  if(myHaveProperties)
-    parseProperties(node);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void RomInfoWidget::setProperties(const Properties& props, const FilesystemNode& node)
+void RomInfoWidget::setRomInfo(const shared_ptr<const RomInfoLoader::RomInfo>& info)
 {
   myHaveProperties = true;
-  myProperties = props;
+  myInfo = info;
 
   // Decide whether the information should be shown immediately
+  // The information may arrive at any time, so a redraw is requested
   if(instance().eventHandler().state() == EventHandlerState::LAUNCHER)
-    parseProperties(node);
+  {
+    parseProperties();
+    setDirty();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -78,7 +72,7 @@ void RomInfoWidget::clearProperties()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void RomInfoWidget::parseProperties(const FilesystemNode& node)
+void RomInfoWidget::parseProperties()
 {
   // Check if a surface has ever been created; if so, we use it
   // The surface will always be the maximum size, but sometimes we'll
@@ -98,15 +92,12 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
   mySurfaceIsValid = false;
   myRomInfo.clear();
 
+  // The snapshot has already been decoded; only the conversion to the
+  // surface format is done here
 #ifdef PNG_SUPPORT
-  // Get a valid filename representing a snapshot file for this rom
-  const string& filename = instance().snapshotLoadDir() +
-      myProperties.get(PropType::Cart_Name) + ".png";
-
-  // Read the PNG file
-  try
+  if(myInfo->haveSnapshot)
   {
-    instance().png().loadImage(filename, *mySurface);
+    instance().png().loadImage(myInfo->snapshot, *mySurface);
 
     // Scale surface to available image area
     const Common::Rect& src = mySurface->srcRect();
@@ -115,50 +106,30 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
     mySurface->setDstSize(uInt32(src.w() * scale), uInt32(src.h() * scale));
     mySurfaceIsValid = true;
   }
-  catch(const runtime_error& e)
-  {
-    mySurfaceErrorMsg = e.what();
-  }
-#else
-  mySurfaceErrorMsg = "PNG image loading not supported";
+  else
 #endif
+    mySurfaceErrorMsg = myInfo->snapshotError;
+
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
 
   // Now add some info for the message box below the image
-  myRomInfo.push_back("Name: " + myProperties.get(PropType::Cart_Name));
-  myRomInfo.push_back("Manufacturer: " + myProperties.get(PropType::Cart_Manufacturer));
-  myRomInfo.push_back("Model: " + myProperties.get(PropType::Cart_ModelNo));
-  myRomInfo.push_back("Rarity: " + myProperties.get(PropType::Cart_Rarity));
-  myRomInfo.push_back("Note: " + myProperties.get(PropType::Cart_Note));
-  bool swappedPorts = myProperties.get(PropType::Console_SwapPorts) == "YES";
-
-  // Load the image for controller auto detection
-  string left = myProperties.get(PropType::Controller_Left);
-  string right = myProperties.get(PropType::Controller_Right);
-  try
-  {
-    ByteBuffer image;
-    string md5 = myProperties.get(PropType::Cart_MD5);
-    uInt32 size = 0;
-
-    if(node.exists() && !node.isDirectory() &&
-      (image = instance().openROM(node, md5, size)) != nullptr)
-    {
-      left = ControllerDetector::detectName(image.get(), size, left,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
-          instance().settings());
-      right = ControllerDetector::detectName(image.get(), size, right,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
-          instance().settings());
-    }
-  }
-  catch(const runtime_error&)
-  {
-    // Do nothing; we simply don't update the controllers if openROM
-    // failed for any reason
-    left = right = "";
-  }
+  const Properties& props = myInfo->props;
+  myRomInfo.push_back("Name: " + props.get(PropType::Cart_Name));
+  myRomInfo.push_back("Manufacturer: " + props.get(PropType::Cart_Manufacturer));
+  myRomInfo.push_back("Model: " + props.get(PropType::Cart_ModelNo));
+  myRomInfo.push_back("Rarity: " + props.get(PropType::Cart_Rarity));
+  myRomInfo.push_back("Note: " + props.get(PropType::Cart_Note));
+
+  // Like in the ROM info of the console, a '*' marks an autodetected type
+  Bankswitch::Type type = Bankswitch::nameToType(props.get(PropType::Cart_Type));
+  if(type != Bankswitch::Type::_AUTO)
+    myRomInfo.push_back("Type: " + Bankswitch::typeToName(type));
+  else if(myInfo->detectedType != "")
+    myRomInfo.push_back("Type: " + myInfo->detectedType + "*");
+
+  const string& left = myInfo->leftController;
+  const string& right = myInfo->rightController;
   if(left != "" && right != "")
     myRomInfo.push_back("Controllers: " + (left + " (left), " + right + " (right)"));
 }
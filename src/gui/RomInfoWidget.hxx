@@ -25,6 +25,7 @@ namespace GUI {
 }
 
 #include "Widget.hxx"
+#include "RomInfoLoader.hxx"
 #include "bspf.hxx"
 
 class RomInfoWidget : public Widget
@@ -34,15 +35,14 @@ class RomInfoWidget : public Widget
                   int x, int y, int w, int h);
     virtual ~RomInfoWidget() = default;
 
-    void setProperties(const Properties& props, const FilesystemNode& node);
+    void setRomInfo(const shared_ptr<const RomInfoLoader::RomInfo>& info);
     void clearProperties();
-    void reloadProperties(const FilesystemNode& node);
 
   protected:
     void drawWidget(bool hilite) override;
 
   private:
-    void parseProperties(const FilesystemNode& node);
+    void parseProperties();
 
   private:
     // Surface pointer holding the PNG image
@@ -54,8 +54,9 @@ class RomInfoWidget : public Widget
     // Some ROM properties info, as well as 'tEXt' chunks from the PNG image
     StringList myRomInfo;
 
-    // The properties for the currently selected ROM
-    Properties myProperties;
+    // The information (properties, snapshot, etc) for the currently
+    // selected ROM
+    shared_ptr<const RomInfoLoader::RomInfo> myInfo;
 
     // Indicates if the current properties should actually be used
     bool myHaveProperties;
@@ -22,6 +22,7 @@
 
 #include "AtariNTSC.hxx"
 #include "AudioSettings.hxx"
+#include "DispatchResult.hxx"
 #include "Serializer.hxx"
 #include "StateManager.hxx"
 #include "Switches.hxx"
@@ -51,6 +52,8 @@ StellaLIBRETRO::StellaLIBRETRO()
   video_phosphor_blend = 60;
 
   rom_image = make_unique<uInt8[]>(getROMMax());
+  state_size = 0;
+  memset(system_ram, 0, sizeof(system_ram));
 
   system_ready = false;
 }
@@ -127,6 +130,15 @@ bool StellaLIBRETRO::create(bool logging)
   video_ready = false;
   audio_samples = 0;
 
+  // Apart from the writes pending in the TIA, the size of a state only
+  // depends on the cartridge type, so the worst case is determined once
+  // instead of for every call of getStateSize()
+  Serializer state;
+  state_size = myOSystem->state().saveState(state)
+    ? state.size() + TIA::maxStateGrowth() : 0;
+
+  memcpy(system_ram, myOSystem->console().system().m6532().getRAM(), 128);
+
   system_ready = true;
   return true;
 }
@@ -138,6 +150,7 @@ void StellaLIBRETRO::destroy()
 
   video_ready = false;
   audio_samples = 0;
+  state_size = 0;
 
   myOSystem.reset();
 }
@@ -146,8 +159,8 @@ void StellaLIBRETRO::destroy()
 void StellaLIBRETRO::runFrame()
 {
   // write ram updates
-  for(int lcv = 0; lcv <= 127; lcv++)
-    myOSystem->console().system().m6532().poke(lcv | 0x80, system_ram[lcv]);
+  M6532& riot = myOSystem->console().system().m6532();
+  memcpy(riot.getRAM(), system_ram, 128);
 
   // poll input right at vsync
   updateInput();
@@ -159,7 +172,7 @@ void StellaLIBRETRO::runFrame()
   updateAudio();
 
   // refresh ram copy
-  memcpy(system_ram, myOSystem->console().system().m6532().getRAM(), 128);
+  memcpy(system_ram, riot.getRAM(), 128);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -178,22 +191,21 @@ void StellaLIBRETRO::updateVideo()
 {
   TIA& tia = myOSystem->console().tia();
 
-  while (1)
-  {
-    tia.updateScanline();
-
-    if(tia.scanlines() == 0) break;
-  }
-
+  // run until the TIA stops the CPU at the end of the frame
+  DispatchResult result;
+  uInt32 frame = tia.frameCount();
+  do
+    tia.update(result);
+  while(result.isSuccess() && tia.frameCount() == frame);
 
   video_ready = tia.newFramePending();
 
   if (video_ready)
   {
-    FrameBuffer& frame = myOSystem->frameBuffer();
+    FrameBuffer& fb = myOSystem->frameBuffer();
 
     tia.renderToFrameBuffer();
-    frame.updateInEmulationMode(0);
+    fb.updateInEmulationMode(0);
   }
 }
 
@@ -206,9 +218,7 @@ void StellaLIBRETRO::updateAudio()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::loadState(const void* data, size_t size)
 {
-  Serializer state;
-
-  state.putByteArray(reinterpret_cast<const uInt8*>(data), static_cast<uInt32>(size));
+  Serializer state(reinterpret_cast<const uInt8*>(data), size);
 
   if(!myOSystem->state().loadState(state))
     return false;
@@ -220,29 +230,16 @@ bool StellaLIBRETRO::loadState(const void* data, size_t size)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::saveState(void* data, size_t size)
 {
-  Serializer state;
-
-  if (!myOSystem->state().saveState(state))
-    return false;
+  Serializer state(reinterpret_cast<uInt8*>(data), size);
 
-  if (state.size() > size)
+  if(!myOSystem->state().saveState(state))
     return false;
 
-  state.getByteArray(reinterpret_cast<uInt8*>(data), static_cast<uInt32>(state.size()));
+  // Clear the rest of the buffer, so that equal states are equal as a whole
+  memset(reinterpret_cast<uInt8*>(data) + state.size(), 0, size - state.size());
   return true;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-size_t StellaLIBRETRO::getStateSize()
-{
-  Serializer state;
-
-  if (!myOSystem->state().saveState(state))
-    return 0;
-
-  return state.size();
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float StellaLIBRETRO::getVideoAspectPar()
 {
@@ -47,7 +47,10 @@ class StellaLIBRETRO
 
     bool create(bool logging);
     void destroy();
-    void reset() { myOSystem->console().system().reset(); }
+    void reset() {
+      myOSystem->console().system().reset();
+      memcpy(system_ram, myOSystem->console().system().m6532().getRAM(), 128);
+    }
 
     void runFrame();
 
@@ -65,7 +68,7 @@ class StellaLIBRETRO
     uInt8* getRAM() { return system_ram; }
     uInt32 getRAMSize() { return 128; }
 
-    size_t getStateSize();
+    size_t getStateSize() { return state_size; }
 
     bool   getConsoleNTSC() { return console_timing == ConsoleTiming::ntsc; }
 
@@ -153,6 +156,10 @@ class StellaLIBRETRO
     // (31440 rate / 50 Hz) * 16-bit stereo * 1.25x padding
     const uInt32 audio_buffer_max = (31440 / 50 * 4 * 5) / 4;
 
+    size_t state_size;
+
+    // A copy of the RIOT RAM, which stays valid when the console is
+    // recreated; frontends keep the pointer to it
     uInt8 system_ram[128];
 
   private:
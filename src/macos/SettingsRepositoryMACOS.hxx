@@ -28,6 +28,8 @@ public:
   void save(const std::map<string, Variant>& values) override;
 
   void save(const string& key, const Variant& value) override;
+
+  void remove(const string& key) override;
 };
 
 #endif // SETTINGS_REPOSITORY_MACOS_HXX
@@ -62,3 +62,13 @@ void SettingsRepositoryMACOS::save(const string& key, const Variant& value)
     ];
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SettingsRepositoryMACOS::remove(const string& key)
+{
+  @autoreleasepool {
+    [[NSUserDefaults standardUserDefaults]
+      removeObjectForKey:[NSString stringWithUTF8String:key.c_str()]
+    ];
+  }
+}
@@ -144,21 +144,18 @@ sub num_prop_types {
   return keys( %prop_type );
 }
 
-# Convert a properties set into a C++ compatible string
-sub build_prop_string {
+# Get the values of a properties set to be compiled in; those which are
+# equal to the default are left empty
+sub build_prop_values {
   my @array = @_;
-  my $result = "  { ";
   my @items = ();
   for (my $i = 0; $i < @array; $i++) {
     if($prop_defaults[$i] ne $array[$i]) {
-      push(@items, "\"$array[$i]\"");
+      push(@items, $array[$i]);
     } else {
-      push(@items, "\"\"");
+      push(@items, "");
     }
   }
 
-  $result .= join(", ", @items);
-  $result .= " }";
-
-  return $result;
+  return @items;
 }
@@ -66,23 +66,57 @@ print OUTFILE "  located in the src/tools directory.  All properties changes\n";
 print OUTFILE "  should be made in stella.pro, and then this file should be\n";
 print OUTFILE "  regenerated and the application recompiled.\n";
 print OUTFILE "*/\n";
+print OUTFILE "#include \"bspf.hxx\"\n";
 print OUTFILE "\n#define DEF_PROPS_SIZE " . $setsize;
 print OUTFILE "\n\n";
-print OUTFILE "static const char* const DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
 
-# Walk the hash map and print each item in order of md5sum
-my $idx = 0;
-for my $key ( sort keys %propset )
-{
-  print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
+# The items are sorted by the value of their md5sum (ignoring case), so
+# they can be found by a binary search on the numeric value
+my @keys = sort { lc($a) cmp lc($b) } keys %propset;
 
-  if ($idx+1 < $setsize) {
-    print OUTFILE ",";
+# Each distinct string is stored only once; items refer to it by index
+my @strings = ( "" );
+my %string_index = ( "" => 0 );
+my @items = ();
+for my $key ( @keys )
+{
+  my @indices = ();
+  for my $value ( PropSet::build_prop_values(@{ $propset{$key} }) )
+  {
+    if (!defined $string_index{$value}) {
+      $string_index{$value} = @strings;
+      push(@strings, $value);
+    }
+    push(@indices, $string_index{$value});
   }
-  print OUTFILE "\n";
-  $idx++;
+  push(@items, "  { " . join(", ", @indices) . " }");
+}
+die "Too many distinct property values\n" if (@strings > 65536);
+
+print OUTFILE "// The md5sum of each item, as two 64-bit halves (most significant first)\n";
+print OUTFILE "static const uInt64 DefPropsMD5[DEF_PROPS_SIZE][2] = {\n";
+my @md5s = ();
+for my $key ( @keys )
+{
+  my $md5 = lc($key);
+  die "Invalid md5sum: $key\n" if ($md5 !~ /^[0-9a-f]{32}$/);
+  push(@md5s, "  { 0x" . substr($md5, 0, 16) . "ULL, 0x" . substr($md5, 16, 16) . "ULL }");
 }
+print OUTFILE join(",\n", @md5s) . "\n";
+print OUTFILE "};\n";
+print OUTFILE "\n";
+
+print OUTFILE "#define DEF_PROPS_STRINGS_SIZE " . @strings;
+print OUTFILE "\n\n";
+print OUTFILE "// The distinct values of all properties\n";
+print OUTFILE "static const char* const DefPropsStrings[DEF_PROPS_STRINGS_SIZE] = {\n";
+print OUTFILE join(",\n", map { "  \"$_\"" } @strings) . "\n";
+print OUTFILE "};\n";
+print OUTFILE "\n";
 
+print OUTFILE "// The properties of each item, as indices into DefPropsStrings\n";
+print OUTFILE "static const uInt16 DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
+print OUTFILE join(",\n", @items) . "\n";
 print OUTFILE "};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
@@ -233,6 +233,57 @@ bool FilesystemNodePOSIX::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getFileInfo(uInt64& size, uInt64& modified) const
+{
+  struct stat st;
+  if(stat(_path.c_str(), &st) != 0)
+    return false;
+
+  // Seconds aren't enough, since a ROM may be rebuilt several times within
+  // one second without changing its size
+#ifdef BSPF_MACOS
+  const struct timespec& mtime = st.st_mtimespec;
+#else
+  const struct timespec& mtime = st.st_mtim;
+#endif
+
+  size = uInt64(st.st_size);
+  modified = uInt64(mtime.tv_sec) * 1000000000 + uInt64(mtime.tv_nsec);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNodePOSIX::map(MappedData& data, uInt32 maxSize) const
+{
+  int fd = open(_path.c_str(), O_RDONLY);
+  if(fd < 0)
+    return 0;
+
+  // Accessing the mapping of a file which was truncated in the meantime
+  // raises SIGBUS, so only files which can't be written are mapped; all
+  // others are read by the caller instead.  The mapping stays valid after
+  // the file is closed.
+  uInt32 size = 0;
+  struct stat st;
+  struct statvfs vfs;
+  if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+     ((st.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)) == 0 ||
+      (fstatvfs(fd, &vfs) == 0 && (vfs.f_flag & ST_RDONLY))))
+  {
+    size = uInt32(std::min(uInt64(st.st_size), uInt64(maxSize)));
+    void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(ptr != MAP_FAILED)
+      data = MappedData(static_cast<const uInt8*>(ptr),
+          [size](const uInt8* p) { munmap(const_cast<uInt8*>(p), size); });
+    else
+      size = 0;
+  }
+  close(fd);
+
+  return size;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNodePtr FilesystemNodePOSIX::getParent() const
 {
@@ -26,6 +26,9 @@
 
 #include <sys/param.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <fcntl.h>
 #include <dirent.h>
 
 #include <cassert>
@@ -70,6 +73,9 @@ class FilesystemNodePOSIX : public AbstractFSNode
     bool isWritable() const override  { return access(_path.c_str(), W_OK) == 0; }
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getFileInfo(uInt64& size, uInt64& modified) const override;
+
+    uInt32 map(MappedData& data, uInt32 maxSize) const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const override;
     AbstractFSNodePtr getParent() const override;
@@ -294,6 +294,59 @@ bool FilesystemNodeWINDOWS::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodeWINDOWS::getFileInfo(uInt64& size, uInt64& modified) const
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if(_isPseudoRoot ||
+     !GetFileAttributesEx(_path.c_str(), GetFileExInfoStandard, &data))
+    return false;
+
+  size = (uInt64(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+  modified = (uInt64(data.ftLastWriteTime.dwHighDateTime) << 32) |
+             data.ftLastWriteTime.dwLowDateTime;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNodeWINDOWS::map(MappedData& data, uInt32 maxSize) const
+{
+  if(_isPseudoRoot)
+    return 0;
+
+  HANDLE file = CreateFile(_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                           NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(file == INVALID_HANDLE_VALUE)
+    return 0;
+
+  // A mapped file can't be modified or deleted until the view is released,
+  // so only read-only files are mapped; all others are read by the caller
+  // instead.  The view stays valid after the file and mapping handles are
+  // closed.
+  uInt32 size = 0;
+  BY_HANDLE_FILE_INFORMATION info;
+  LARGE_INTEGER length;
+  if(GetFileInformationByHandle(file, &info) &&
+     (info.dwFileAttributes & FILE_ATTRIBUTE_READONLY) &&
+     GetFileSizeEx(file, &length) && length.QuadPart > 0)
+  {
+    size = uInt32(std::min(uInt64(length.QuadPart), uInt64(maxSize)));
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* ptr = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size) : NULL;
+    if(ptr)
+      data = MappedData(static_cast<const uInt8*>(ptr),
+          [](const uInt8* p) { UnmapViewOfFile(p); });
+    else
+      size = 0;
+
+    if(mapping)
+      CloseHandle(mapping);
+  }
+  CloseHandle(file);
+
+  return size;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNodePtr FilesystemNodeWINDOWS::getParent() const
 {
@@ -67,6 +67,9 @@ class FilesystemNodeWINDOWS : public AbstractFSNode
     bool isWritable() const override;
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getFileInfo(uInt64& size, uInt64& modified) const override;
+
+    uInt32 map(MappedData& data, uInt32 maxSize) const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const override;
     AbstractFSNodePtr getParent() const override;